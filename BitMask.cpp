@@ -0,0 +1,468 @@
+/* BitMask.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for packed skin masks and their morphology.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <stdint.h>
+#include <vector>
+
+#include "image.h"
+#include "BitMask.h"
+#include "Parallel.h"
+
+
+// Functions
+
+/* initBitMask():
+ * 	Sets up a clear mask.
+ * args:
+ * 	@rows: Rows of pixels.
+ * 	@cols: Columns of pixels.
+ * 	@mask: Location to store the mask.
+ * return:
+ * 	void
+ */
+void initBitMask(int rows, int cols, BitMask& mask) {
+	mask.rows = rows;
+	mask.cols = cols;
+	mask.words = (cols + 63) / 64;
+	mask.bits.assign((size_t)rows * mask.words, 0);
+}
+
+
+/* getMaskBit():
+ * 	Tests one pixel of a mask.
+ * args:
+ * 	@mask: The mask.
+ * 	@i: The row.
+ * 	@j: The column.
+ * return:
+ * 	bool: true if set.
+ */
+inline bool getMaskBit(const BitMask& mask, int i, int j) {
+	return (mask.bits[(size_t)i * mask.words + j / 64] >> (j % 64)) & 1;
+}
+
+
+/* tailBits():
+ * 	Gets the bits of the last word of a row that hold pixels.
+ * args:
+ * 	@mask: The mask.
+ * return:
+ * 	uint64_t: The bits in use.
+ */
+uint64_t tailBits(const BitMask& mask) {
+	return mask.cols % 64 == 0 ? ~(uint64_t)0 : ((uint64_t)1 << (mask.cols % 64)) - 1;
+}
+
+
+/* maskFromImage():
+ * 	Packs a classified image (non-zero red=skin) into a mask.
+ * args:
+ * 	@image: The classified image.
+ * 	@mask: Location to store the mask.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void maskFromImage(ImageType& image, BitMask& mask, int threads) {
+	int rows, cols, levels;
+
+	image.getImageInfo(rows, cols, levels);
+	initBitMask(rows, cols, mask);
+	parallelFor(rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			const int* row = image.getRow(i);
+			uint64_t* out = &mask.bits[(size_t)i * mask.words];
+			for(int j = 0; j < cols; j++) {
+				out[j / 64] |= (uint64_t)(row[j*3] != 0) << (j % 64);
+			}
+		}
+	});
+}
+
+
+/* maskFromBytes():
+ * 	Packs one value per pixel (non-zero=skin), as written by
+ * 	classifyForBuffer() and the stream classifier, into a mask.
+ * args:
+ * 	@values: The values, row by row.
+ * 	@rows: Rows of pixels.
+ * 	@cols: Columns of pixels.
+ * 	@mask: Location to store the mask.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void maskFromBytes(const unsigned char* values, int rows, int cols, BitMask& mask, int threads) {
+	initBitMask(rows, cols, mask);
+	parallelFor(rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			const unsigned char* row = values + (size_t)i * cols;
+			uint64_t* out = &mask.bits[(size_t)i * mask.words];
+			for(int j = 0; j < cols; j++) {
+				out[j / 64] |= (uint64_t)(row[j] != 0) << (j % 64);
+			}
+		}
+	});
+}
+
+
+/* bytesFromMask():
+ * 	Unpacks a mask into one value per pixel (255=set, 0=clear).
+ * args:
+ * 	@mask: The mask.
+ * 	@values: Location to output the values, row by row.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void bytesFromMask(const BitMask& mask, unsigned char* values, int threads) {
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			const uint64_t* in = &mask.bits[(size_t)i * mask.words];
+			unsigned char* row = values + (size_t)i * mask.cols;
+			for(int j = 0; j < mask.cols; j++) {
+				row[j] = (in[j / 64] >> (j % 64)) & 1 ? 255 : 0;
+			}
+		}
+	});
+}
+
+
+/* imageFromMask():
+ * 	Unpacks a mask into an image (white=set, black=clear).
+ * args:
+ * 	@mask: The mask.
+ * 	@image: Location to output the pixels (same size as the mask).
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void imageFromMask(const BitMask& mask, ImageType& image, int threads) {
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		RGB val;
+		for(int i = begin; i < end; i++) {
+			for(int j = 0; j < mask.cols; j++) {
+				int level = getMaskBit(mask, i, j) ? 255 : 0;
+				val.r = level;
+				val.g = level;
+				val.b = level;
+				image.setPixelVal(i, j, val);
+			}
+		}
+	});
+}
+
+
+/* morphRow():
+ * 	Applies the row pass of an erosion or dilation to one row.
+ * 	Each step takes in the neighbour on both sides by shifting the
+ * 	words one bit, carrying across word boundaries.
+ * args:
+ * 	@in: The row to read.
+ * 	@out: Location to store the result.
+ * 	@work: Space for one row.
+ * 	@words: Words per row.
+ * 	@tail: The bits of the last word that hold pixels.
+ * 	@radius: The number of steps.
+ * 	@erode: true to erode, false to dilate.
+ * return:
+ * 	void
+ */
+void morphRow(const uint64_t* in, uint64_t* out, uint64_t* work, int words, uint64_t tail,
+	int radius, bool erode) {
+	// Outside pixels are set for erosion and clear for dilation
+	uint64_t fill = erode ? ~(uint64_t)0 : 0;
+
+	for(int w = 0; w < words; w++) {
+		out[w] = in[w];
+	}
+	for(int step = 0; step < radius; step++) {
+		out[words - 1] = (out[words - 1] & tail) | (fill & ~tail);
+		for(int w = 0; w < words; w++) {
+			uint64_t left = (out[w] << 1) | ((w > 0 ? out[w - 1] : fill) >> 63);
+			uint64_t right = (out[w] >> 1) | ((w + 1 < words ? out[w + 1] : fill) << 63);
+			work[w] = erode ? out[w] & left & right : out[w] | left | right;
+		}
+		for(int w = 0; w < words; w++) {
+			out[w] = work[w];
+		}
+	}
+	out[words - 1] &= tail;
+}
+
+
+/* morphMask():
+ * 	Erodes or dilates a mask: a row pass into a second buffer, then
+ * 	a column pass back into the mask.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@erode: true to erode, false to dilate.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void morphMask(BitMask& mask, int radius, bool erode, int threads) {
+	int words = mask.words;
+	uint64_t tail = tailBits(mask);
+
+	if(radius < 1 || mask.rows == 0 || words == 0) {
+		return;
+	}
+
+	std::vector<uint64_t> rowPass(mask.bits.size());
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		std::vector<uint64_t> work(words);
+		for(int i = begin; i < end; i++) {
+			morphRow(&mask.bits[(size_t)i * words], &rowPass[(size_t)i * words],
+				work.data(), words, tail, radius, erode);
+		}
+	});
+
+	// Rows outside the image are left out of the column pass
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			int first = i - radius < 0 ? 0 : i - radius;
+			int last = i + radius >= mask.rows ? mask.rows - 1 : i + radius;
+			uint64_t* out = &mask.bits[(size_t)i * words];
+			for(int w = 0; w < words; w++) {
+				uint64_t val = rowPass[(size_t)first * words + w];
+				for(int k = first + 1; k <= last; k++) {
+					uint64_t next = rowPass[(size_t)k * words + w];
+					val = erode ? val & next : val | next;
+				}
+				out[w] = val;
+			}
+		}
+	});
+}
+
+
+/* erodeMask():
+ * 	Keeps the pixels whose whole neighbourhood is set.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void erodeMask(BitMask& mask, int radius, int threads) {
+	morphMask(mask, radius, true, threads);
+}
+
+
+/* dilateMask():
+ * 	Sets the pixels with any neighbour set.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void dilateMask(BitMask& mask, int radius, int threads) {
+	morphMask(mask, radius, false, threads);
+}
+
+
+/* openMask():
+ * 	Erodes then dilates a mask, removing specks smaller than the
+ * 	neighbourhood.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void openMask(BitMask& mask, int radius, int threads) {
+	morphMask(mask, radius, true, threads);
+	morphMask(mask, radius, false, threads);
+}
+
+
+/* closeMask():
+ * 	Dilates then erodes a mask, filling holes smaller than the
+ * 	neighbourhood.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void closeMask(BitMask& mask, int radius, int threads) {
+	morphMask(mask, radius, false, threads);
+	morphMask(mask, radius, true, threads);
+}
+
+
+/* runsForRow():
+ * 	Finds the runs of set pixels of a row, skipping to each change
+ * 	with a count of trailing zeros.
+ * args:
+ * 	@row: The words of the row.
+ * 	@words: Words per row.
+ * 	@cols: Columns of pixels.
+ * 	@runs: Location to add the runs to.
+ * return:
+ * 	void
+ */
+void runsForRow(const uint64_t* row, int words, int cols, std::vector<MaskRun>& runs) {
+	int start = -1;
+
+	for(int w = 0; w < words; w++) {
+		uint64_t x = row[w];
+		int pos = 0;
+
+		while(pos < 64) {
+			// Look for the next set bit, or the next clear bit in a run
+			uint64_t y = (start < 0 ? x : ~x) >> pos;
+			if(y == 0) {
+				break;
+			}
+			pos += __builtin_ctzll(y);
+			if(start < 0) {
+				start = w * 64 + pos;
+			}
+			else {
+				MaskRun run = { start, w * 64 + pos };
+				runs.push_back(run);
+				start = -1;
+			}
+		}
+	}
+	if(start >= 0) {
+		MaskRun run = { start, cols };
+		runs.push_back(run);
+	}
+}
+
+
+/* clearMaskRange():
+ * 	Clears a range of pixels of a row a word at a time.
+ * args:
+ * 	@row: The words of the row.
+ * 	@start: First column to clear.
+ * 	@end: Column after the range.
+ * return:
+ * 	void
+ */
+void clearMaskRange(uint64_t* row, int start, int end) {
+	for(int w = start / 64; w * 64 < end; w++) {
+		int lo = start > w * 64 ? start - w * 64 : 0;
+		int hi = end < w * 64 + 64 ? end - w * 64 : 64;
+		uint64_t bits = (hi == 64 ? ~(uint64_t)0 : ((uint64_t)1 << hi) - 1)
+			& ~(((uint64_t)1 << lo) - 1);
+		row[w] &= ~bits;
+	}
+}
+
+
+/* findRoot():
+ * 	Finds the region of a run, shortening the path as it goes.
+ * args:
+ * 	@parent: The parent of each run.
+ * 	@k: The run.
+ * return:
+ * 	long: The run that stands for the region.
+ */
+long findRoot(std::vector<long>& parent, long k) {
+	while(parent[k] != k) {
+		parent[k] = parent[parent[k]];
+		k = parent[k];
+	}
+	return k;
+}
+
+
+/* removeSmallComponents():
+ * 	Clears every 8-connected region of set pixels smaller than a
+ * 	size. Runs of set pixels are found from whole words in row
+ * 	bands, joined across rows, then cleared in row bands.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@minSize: The fewest pixels a region may keep.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	long: The number of regions removed.
+ */
+long removeSmallComponents(BitMask& mask, long minSize, int threads) {
+	std::vector<std::vector<MaskRun> > runs(mask.rows);
+	std::vector<long> first(mask.rows + 1, 0);
+	long removed = 0;
+
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			runsForRow(&mask.bits[(size_t)i * mask.words], mask.words, mask.cols, runs[i]);
+		}
+	});
+	for(int i = 0; i < mask.rows; i++) {
+		first[i + 1] = first[i] + runs[i].size();
+	}
+
+	// Join runs that touch, including at corners, across each pair of rows
+	std::vector<long> parent(first[mask.rows]);
+	for(long k = 0; k < first[mask.rows]; k++) {
+		parent[k] = k;
+	}
+	for(int i = 1; i < mask.rows; i++) {
+		const std::vector<MaskRun>& above = runs[i - 1];
+		const std::vector<MaskRun>& below = runs[i];
+		size_t a = 0, b = 0;
+
+		while(a < above.size() && b < below.size()) {
+			if(above[a].start <= below[b].end && below[b].start <= above[a].end) {
+				long ra = findRoot(parent, first[i - 1] + a);
+				long rb = findRoot(parent, first[i] + b);
+				if(ra != rb) {
+					parent[ra > rb ? ra : rb] = ra < rb ? ra : rb;
+				}
+			}
+			if(above[a].end < below[b].end) {
+				a++;
+			}
+			else {
+				b++;
+			}
+		}
+	}
+
+	// Size each region, then mark each run with its region
+	std::vector<long> size(parent.size(), 0);
+	for(int i = 0; i < mask.rows; i++) {
+		for(size_t r = 0; r < runs[i].size(); r++) {
+			size[findRoot(parent, first[i] + r)] += runs[i][r].end - runs[i][r].start;
+		}
+	}
+	for(size_t k = 0; k < parent.size(); k++) {
+		parent[k] = findRoot(parent, k);
+		removed += parent[k] == (long)k && size[k] < minSize;
+	}
+
+	parallelFor(mask.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			uint64_t* row = &mask.bits[(size_t)i * mask.words];
+			for(size_t r = 0; r < runs[i].size(); r++) {
+				const MaskRun& run = runs[i][r];
+				if(size[parent[first[i] + r]] >= minSize) {
+					continue;
+				}
+				clearMaskRange(row, run.start, run.end);
+			}
+		}
+	});
+
+	return removed;
+}
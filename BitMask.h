@@ -0,0 +1,202 @@
+/* BitMask.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for skin masks packed 64 pixels to a word and
+ * 	the morphological operations used to clean them.
+ *
+ * 	Bit k of word w of a row holds pixel 64*w + k, so neighbours
+ * 	along a row are reached by shifting whole words. Operations use
+ * 	a square structuring element of side 2*radius+1, applied as a
+ * 	row pass and then a column pass, each split into row bands.
+ * 	Pixels outside the image are ignored: they neither erode nor
+ * 	dilate the mask.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef BITMASK_H_
+#define BITMASK_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "image.h"
+
+/* BitMask:
+ * 	A binary mask, one bit per pixel. Bits past the last column of
+ * 	a row are always clear.
+ */
+struct BitMask {
+	int rows;                      // rows: Rows of pixels.
+	int cols;                      // cols: Columns of pixels.
+	int words;                     // words: Words per row.
+	std::vector<uint64_t> bits;    // bits: The rows, one after another.
+};
+
+/* MaskRun:
+ * 	A run of set pixels within a row.
+ */
+struct MaskRun {
+	int start;   // start: First column of the run.
+	int end;     // end: Column after the run.
+};
+
+
+/* initBitMask():
+ * 	Sets up a clear mask.
+ * args:
+ * 	@rows: Rows of pixels.
+ * 	@cols: Columns of pixels.
+ * 	@mask: Location to store the mask.
+ * return:
+ * 	void
+ */
+void initBitMask(int rows, int cols, BitMask& mask);
+
+
+/* getMaskBit():
+ * 	Tests one pixel of a mask.
+ * args:
+ * 	@mask: The mask.
+ * 	@i: The row.
+ * 	@j: The column.
+ * return:
+ * 	bool: true if set.
+ */
+inline bool getMaskBit(const BitMask& mask, int i, int j);
+
+
+/* maskFromImage():
+ * 	Packs a classified image (non-zero red=skin) into a mask.
+ * args:
+ * 	@image: The classified image.
+ * 	@mask: Location to store the mask.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void maskFromImage(ImageType& image, BitMask& mask, int threads = 0);
+
+
+/* maskFromBytes():
+ * 	Packs one value per pixel (non-zero=skin), as written by
+ * 	classifyForBuffer() and the stream classifier, into a mask.
+ * args:
+ * 	@values: The values, row by row.
+ * 	@rows: Rows of pixels.
+ * 	@cols: Columns of pixels.
+ * 	@mask: Location to store the mask.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void maskFromBytes(const unsigned char* values, int rows, int cols, BitMask& mask, int threads = 0);
+
+
+/* bytesFromMask():
+ * 	Unpacks a mask into one value per pixel (255=set, 0=clear).
+ * args:
+ * 	@mask: The mask.
+ * 	@values: Location to output the values, row by row.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void bytesFromMask(const BitMask& mask, unsigned char* values, int threads = 0);
+
+
+/* imageFromMask():
+ * 	Unpacks a mask into an image (white=set, black=clear).
+ * args:
+ * 	@mask: The mask.
+ * 	@image: Location to output the pixels (same size as the mask).
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void imageFromMask(const BitMask& mask, ImageType& image, int threads = 0);
+
+
+/* runsForRow():
+ * 	Finds the runs of set pixels of a row, skipping to each change
+ * 	with a count of trailing zeros.
+ * args:
+ * 	@row: The words of the row.
+ * 	@words: Words per row.
+ * 	@cols: Columns of pixels.
+ * 	@runs: Location to add the runs to.
+ * return:
+ * 	void
+ */
+void runsForRow(const uint64_t* row, int words, int cols, std::vector<MaskRun>& runs);
+
+
+/* erodeMask():
+ * 	Keeps the pixels whose whole neighbourhood is set.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void erodeMask(BitMask& mask, int radius, int threads = 0);
+
+
+/* dilateMask():
+ * 	Sets the pixels with any neighbour set.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void dilateMask(BitMask& mask, int radius, int threads = 0);
+
+
+/* openMask():
+ * 	Erodes then dilates a mask, removing specks smaller than the
+ * 	neighbourhood.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void openMask(BitMask& mask, int radius, int threads = 0);
+
+
+/* closeMask():
+ * 	Dilates then erodes a mask, filling holes smaller than the
+ * 	neighbourhood.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@radius: Radius of the square neighbourhood.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void closeMask(BitMask& mask, int radius, int threads = 0);
+
+
+/* removeSmallComponents():
+ * 	Clears every 8-connected region of set pixels smaller than a
+ * 	size. Runs of set pixels are found from whole words in row
+ * 	bands, joined across rows, then cleared in row bands.
+ * args:
+ * 	@mask: The mask to change.
+ * 	@minSize: The fewest pixels a region may keep.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	long: The number of regions removed.
+ */
+long removeSmallComponents(BitMask& mask, long minSize, int threads = 0);
+
+#include "BitMask.cpp"
+
+#endif
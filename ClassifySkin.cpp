@@ -11,98 +11,47 @@
 
 
 // Libraries
+#include <mutex>
+#include <vector>
+
 #include "image.h"
 #include "rgb.h"
 #include "classification.hpp"
+#include "SkinModel.h"
+#include "ExperimentModels.h"
+#include "SkinRegion.h"
+#include "ColourSpace.h"
+#include "Parallel.h"
 #include "Eigen/Dense"
 
 // Functions
 
 /* classifyForPixel():
- * 	Classifies a pixel value as either skin or not skin.
+ * 	Classifies a pixel value as either skin or not skin, using the
+ * 	compile-time RGBSkinModel from ExperimentModels.h. The folded
+ * 	constants round differently from the old per-pixel Eigen
+ * 	evaluation, so a handful of rg colours whose score lies within
+ * 	float rounding of the threshold can land on the other side.
  * args:
  * 	@pix: The pixel to classify.
  * return:
- * 	true: if the pixel is classified as skin.
- * 	false: otherwise.
+ * 	float: The discriminant value. Skin if greater than the threshold.
  */
 float classifyForPixel(RGB& pix) {
-	// Priors
-	float pIsSkin = 0.0671455;
-
-	// Sample mean
-	Eigen::Vector2f mu;
-	mu << 0.432223, 0.295772;
-
-	// Sample covariance matrix
-	Eigen::Matrix2f covm;
-	covm << 0.00243317, -0.00111725,
-	     -0.00111725, 0.000788423;
-
-	int samples = 2;
-
-	// Calculate pixel feature values
-	float r, g;
-	int rgbSum = pix.r + pix.g + pix.b;
-	if(rgbSum == 0) {
-		r = 0;
-		g = 0;
-	}
-	else {
-		r = (float)pix.r / rgbSum;
-		g = (float)pix.g / rgbSum;
-	}
-	Eigen::Vector2f x(r, g);
-
-	// Calculate conditional probability
-	//Eigen::IOFormat CleanFmt(4, 0, ", ", "\n", "[", "]");
-	
-	float prob = (x.transpose() * (-0.5 * covm.inverse()) * x);
-	prob += ((covm.inverse() * mu).transpose() * x);
-	prob += (-0.5 * mu.transpose() * covm.inverse() * mu);
-	prob += (-0.5 * log(covm.determinant()));
-	
-	return prob;
+	return scoreForPixelStatic<RGBSkinModel>(pix);
 }
 
 
 /* classifyForPixelYCC():
- * 	Classifies a pixel value as either skin or not skin.
+ * 	Classifies a pixel value as either skin or not skin, using the
+ * 	compile-time YCCSkinModel from ExperimentModels.h.
  * args:
  * 	@pix: The pixel to classify.
  * return:
- * 	true: if the pixel is classified as skin.
- * 	false: otherwise.
+ * 	float: The discriminant value. Skin if greater than the threshold.
  */
 float classifyForPixelYCC(RGB& pix) {
-	// Priors
-	float pIsSkin = 0.0671455;
-
-	// Sample mean
-	Eigen::Vector2f mu;
-	mu << 23.639, 22.2349;
-
-	// Sample covariance matrix
-	Eigen::Matrix2f covm;
-	covm << 48.9502, -0.328258,
-	     -0.328258, 176.884;
-
-	int samples = 2;
-
-	// Calculate pixel feature values
-	float r, g;
-	r = (0.500 * pix.r) - (0.419 * pix.g) - (0.081 * pix.b);
-	g = - (0.169 * pix.r) - (0.0332 * pix.g) + (0.500 * pix.b);
-	Eigen::Matrix<float, 2, 1> x(r, g);
-
-	// Calculate conditional probability
-	//Eigen::IOFormat CleanFmt(4, 0, ", ", "\n", "[", "]");
-	
-	float prob = (x.transpose() * (-0.5 * covm.inverse()) * x);
-	prob += ((covm.inverse() * mu).transpose() * x);
-	prob += (-0.5 * mu.transpose() * covm.inverse() * mu) + (-0.5 * log(covm.determinant()));
-	
-	return prob;
+	return scoreForPixelStatic<YCCSkinModel>(pix);
 }
 
 	
@@ -158,6 +107,114 @@ void classifyForImage(ImageType& source, ImageType& dest, float t, bool type = t
 }
 
 
+/* classifyForImage():
+ * 	Classifies skin pixels within an image using a trained model.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@model: The model and threshold to classify with.
+ * return:
+ * 	void
+ */
+void classifyForImage(ImageType& source, ImageType& dest, const SkinModel& model) {
+	// Variables
+	int rows, cols, levels;
+
+	// Get image metadata
+	source.getImageInfo(rows, cols, levels);
+
+	// Get box around accepted colours
+	SkinPrefilter filter;
+	prepareSkinPrefilter(model, filter);
+
+	// Loop through source image rows in the bands they were allocated in
+	parallelFor(rows, imageBands(rows, cols), [&](int begin, int end) {
+		std::vector<float> x0(cols), x1(cols);
+		RGB val;
+
+		for(int i = begin; i < end; i++) {
+			const int* row = source.getRow(i);
+			featuresForPixels(model.isRGB, row, cols, x0.data(), x1.data());
+
+			for(int j = 0; j < cols; j++) {
+				// Output classification to destination image
+				bool skin = passesSkinPrefilter(row[j*3], row[j*3+1], row[j*3+2], filter)
+					&& scoreForFeatures(x0[j], x1[j], model) > model.t;
+				int level = skin ? 255 : 0;
+				val.r = level;
+				val.g = level;
+				val.b = level;
+				dest.setPixelVal(i, j, val);
+			}
+		}
+	});
+}
+
+
+/* classifyForBuffer():
+ * 	Classifies skin pixels within raw 8-bit interleaved RGB values.
+ * args:
+ * 	@pixels: The RGB values to classify, row by row.
+ * 	@count: The number of pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForBuffer(const unsigned char* pixels, long count, const SkinModel& model, unsigned char* mask) {
+	float x0[256], x1[256];
+	SkinPrefilter filter;
+
+	prepareSkinPrefilter(model, filter);
+
+	// Convert and classify a span at a time
+	for(long k = 0; k < count; k += 256) {
+		int n = count - k < 256 ? (int)(count - k) : 256;
+		const unsigned char* span = pixels + k*3;
+		featuresForPixels(model.isRGB, span, n, x0, x1);
+
+		for(int p = 0; p < n; p++) {
+			bool skin = passesSkinPrefilter(span[p*3], span[p*3+1], span[p*3+2], filter)
+				&& scoreForFeatures(x0[p], x1[p], model) > model.t;
+			mask[k + p] = skin ? 255 : 0;
+		}
+	}
+}
+
+
+/* classifyForPlanes():
+ * 	Classifies skin pixels within raw 8-bit planar RGB values.
+ * args:
+ * 	@r: The red values, row by row.
+ * 	@g: The green values, row by row.
+ * 	@b: The blue values, row by row.
+ * 	@count: The number of pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForPlanes(const unsigned char* r, const unsigned char* g, const unsigned char* b,
+	long count, const SkinModel& model, unsigned char* mask) {
+	float x0[256], x1[256];
+	SkinPrefilter filter;
+
+	prepareSkinPrefilter(model, filter);
+
+	// Convert and classify a span at a time
+	for(long k = 0; k < count; k += 256) {
+		int n = count - k < 256 ? (int)(count - k) : 256;
+		featuresForPlanes(model.isRGB, r + k, g + k, b + k, n, x0, x1);
+
+		for(int p = 0; p < n; p++) {
+			bool skin = passesSkinPrefilter(r[k+p], g[k+p], b[k+p], filter)
+				&& scoreForFeatures(x0[p], x1[p], model) > model.t;
+			mask[k + p] = skin ? 255 : 0;
+		}
+	}
+}
+
+
 /* getMisclass():
  * 	Gets the number of pixels misclassified in an image.
  * args:
@@ -170,43 +227,49 @@ void classifyForImage(ImageType& source, ImageType& dest, float t, bool type = t
  */
 void getMisclass(ImageType& image, ImageType& ref, int& fp, int& fn) {
 	// Variables
-	int rows, cols, levels, count;
-	RGB imagePix, refPix;
+	int rows, cols, levels;
+	std::mutex lock;
 
 	// Initialize variables
-	count = 0;
 	fp = 0;
 	fn = 0;
 	image.getImageInfo(rows, cols, levels);
 
-	// Loop through image pixel rows
-	for(int i = 0; i < rows; i++) {
-		// Loop through image pixel columns
-		for(int j = 0; j < cols * 3; j += 3) {
-			// Get pixels
-			image.getPixelVal(i, j/3, imagePix);
-			ref.getPixelVal(i, j/3, refPix);
-
-			// Convert red reference to white
-			if(refPix.r == 252 && refPix.g == 3 && refPix.b == 3) {
-				refPix.r = 255;
-				refPix.g = 255;
-				refPix.b = 255;
-			}
+	// Count each band of rows on its own, then add the counts together
+	parallelFor(rows, imageBands(rows, cols), [&](int begin, int end) {
+		RGB imagePix, refPix;
+		int bandFp = 0, bandFn = 0;
 
-			// Test for inequality
-			if(imagePix.r != refPix.r || imagePix.g != refPix.g || imagePix.b != refPix.b) {
-				//std::cout << std::endl << imagePix.r << " " << imagePix.g << " " << imagePix.b << std::endl;
-				//std::cout << refPix.r << " " << refPix.g << " " << refPix.b << std::endl;
-				// Test for false positive
-				if(imagePix.r == 255 && imagePix.g == 255 && imagePix.b == 255) {
-					fp++;
+		for(int i = begin; i < end; i++) {
+			// Loop through image pixel columns
+			for(int j = 0; j < cols * 3; j += 3) {
+				// Get pixels
+				image.getPixelVal(i, j/3, imagePix);
+				ref.getPixelVal(i, j/3, refPix);
+
+				// Convert red reference to white
+				if(refPix.r == 252 && refPix.g == 3 && refPix.b == 3) {
+					refPix.r = 255;
+					refPix.g = 255;
+					refPix.b = 255;
 				}
-				// Default to false negative
-				else {
-					fn++;
+
+				// Test for inequality
+				if(imagePix.r != refPix.r || imagePix.g != refPix.g || imagePix.b != refPix.b) {
+					// Test for false positive
+					if(imagePix.r == 255 && imagePix.g == 255 && imagePix.b == 255) {
+						bandFp++;
+					}
+					// Default to false negative
+					else {
+						bandFn++;
+					}
 				}
 			}
 		}
-	}
+
+		std::lock_guard<std::mutex> hold(lock);
+		fp += bandFp;
+		fn += bandFn;
+	});
 }
@@ -12,6 +12,8 @@
 #ifndef CLASSIFYSKIN_H_
 #define CLASSIFYSKIN_H_
 
+#include "SkinModel.h"
+
 /* classifyForPixel():
  * 	Classifies a pixel value as either skin or not skin.
  * args:
@@ -34,6 +36,44 @@ bool classifyForPixel(RGB& pix, float t);
  */
 void classifyForImage(ImageType& source, ImageType& dest, float t);
 
+/* classifyForImage():
+ * 	Classifies skin pixels within an image using a trained model.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@model: The model and threshold to classify with.
+ * return:
+ * 	void
+ */
+void classifyForImage(ImageType& source, ImageType& dest, const SkinModel& model);
+
+/* classifyForBuffer():
+ * 	Classifies skin pixels within raw 8-bit interleaved RGB values.
+ * args:
+ * 	@pixels: The RGB values to classify, row by row.
+ * 	@count: The number of pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForBuffer(const unsigned char* pixels, long count, const SkinModel& model, unsigned char* mask);
+
+/* classifyForPlanes():
+ * 	Classifies skin pixels within raw 8-bit planar RGB values.
+ * args:
+ * 	@r: The red values, row by row.
+ * 	@g: The green values, row by row.
+ * 	@b: The blue values, row by row.
+ * 	@count: The number of pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForPlanes(const unsigned char* r, const unsigned char* g, const unsigned char* b,
+	long count, const SkinModel& model, unsigned char* mask);
+
 /* getMisclass():
  * 	Gets the number of pixels misclassified in an image.
  * args:
@@ -0,0 +1,177 @@
+/* ColourSpace.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for converting RGB pixel values to the 2D colour
+ * 	features used by the skin models.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include "image.h"
+#include "ColourSpace.h"
+#include "Parallel.h"
+
+#define FEATURE_CHUNK 64     // Pixels converted per SIMD-friendly chunk.
+
+
+// Functions
+
+/* featuresForPixel():
+ * 	Converts one pixel value to its colour features.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * 	@x0: Location to store the first feature.
+ * 	@x1: Location to store the second feature.
+ * return:
+ * 	void
+ */
+inline void featuresForPixel(bool isRGB, int r, int g, int b, float& x0, float& x1) {
+	if(isRGB) {
+		int rgbSum = r + g + b;
+		x0 = rgbSum == 0 ? 0 : (float)r / rgbSum;
+		x1 = rgbSum == 0 ? 0 : (float)g / rgbSum;
+	}
+	else {
+		x0 = (yccWeights[0][0] * r) + (yccWeights[0][1] * g) + (yccWeights[0][2] * b);
+		x1 = (yccWeights[1][0] * r) + (yccWeights[1][1] * g) + (yccWeights[1][2] * b);
+	}
+}
+
+
+/* featuresForChunk():
+ * 	Converts up to FEATURE_CHUNK interleaved pixels. Channels are
+ * 	first split into planes, then every feature is computed with
+ * 	straight-line loops over the planes.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@rgb: The interleaved values.
+ * 	@count: The number of pixels (at most FEATURE_CHUNK).
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * return:
+ * 	void
+ */
+template<typename T>
+void featuresForChunk(bool isRGB, const T* rgb, int count, float* x0, float* x1) {
+	int r[FEATURE_CHUNK], g[FEATURE_CHUNK], b[FEATURE_CHUNK];
+
+	// Split channels
+	for(int k = 0; k < count; k++) {
+		r[k] = rgb[k*3];
+		g[k] = rgb[k*3+1];
+		b[k] = rgb[k*3+2];
+	}
+
+	if(isRGB) {
+		for(int k = 0; k < count; k++) {
+			int rgbSum = r[k] + g[k] + b[k];
+			float sum = rgbSum == 0 ? 1.0f : (float)rgbSum;
+			x0[k] = rgbSum == 0 ? 0.0f : (float)r[k] / sum;
+			x1[k] = rgbSum == 0 ? 0.0f : (float)g[k] / sum;
+		}
+	}
+	else {
+		for(int k = 0; k < count; k++) {
+			x0[k] = (yccWeights[0][0] * r[k]) + (yccWeights[0][1] * g[k]) + (yccWeights[0][2] * b[k]);
+			x1[k] = (yccWeights[1][0] * r[k]) + (yccWeights[1][1] * g[k]) + (yccWeights[1][2] * b[k]);
+		}
+	}
+}
+
+
+/* featuresForPixels():
+ * 	Converts a span of interleaved RGB values to planar features.
+ * 	Works in fixed-size chunks that the compiler turns into SIMD
+ * 	code; results match featuresForPixel() exactly.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@rgb: The interleaved values (e.g. an image row).
+ * 	@count: The number of pixels.
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * return:
+ * 	void
+ */
+void featuresForPixels(bool isRGB, const int* rgb, long count, float* x0, float* x1) {
+	for(long k = 0; k < count; k += FEATURE_CHUNK) {
+		int n = count - k < FEATURE_CHUNK ? (int)(count - k) : FEATURE_CHUNK;
+		featuresForChunk(isRGB, rgb + k*3, n, x0 + k, x1 + k);
+	}
+}
+
+void featuresForPixels(bool isRGB, const unsigned char* rgb, long count, float* x0, float* x1) {
+	for(long k = 0; k < count; k += FEATURE_CHUNK) {
+		int n = count - k < FEATURE_CHUNK ? (int)(count - k) : FEATURE_CHUNK;
+		featuresForChunk(isRGB, rgb + k*3, n, x0 + k, x1 + k);
+	}
+}
+
+
+/* featuresForPlanes():
+ * 	Converts a span of planar RGB values to planar features. No
+ * 	channel split is needed, so the loops vectorize directly;
+ * 	results match featuresForPixel() exactly.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@r: The red values.
+ * 	@g: The green values.
+ * 	@b: The blue values.
+ * 	@count: The number of pixels.
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * return:
+ * 	void
+ */
+void featuresForPlanes(bool isRGB, const unsigned char* r, const unsigned char* g,
+	const unsigned char* b, long count, float* x0, float* x1) {
+	if(isRGB) {
+		for(long k = 0; k < count; k++) {
+			int rgbSum = r[k] + g[k] + b[k];
+			float sum = rgbSum == 0 ? 1.0f : (float)rgbSum;
+			x0[k] = rgbSum == 0 ? 0.0f : (float)r[k] / sum;
+			x1[k] = rgbSum == 0 ? 0.0f : (float)g[k] / sum;
+		}
+	}
+	else {
+		for(long k = 0; k < count; k++) {
+			x0[k] = (yccWeights[0][0] * r[k]) + (yccWeights[0][1] * g[k]) + (yccWeights[0][2] * b[k]);
+			x1[k] = (yccWeights[1][0] * r[k]) + (yccWeights[1][1] * g[k]) + (yccWeights[1][2] * b[k]);
+		}
+	}
+}
+
+
+/* featuresForImage():
+ * 	Converts a whole image to planar feature arrays, one entry per
+ * 	pixel in row order. Rows are split across threads.
+ * args:
+ * 	@image: The image to convert.
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void featuresForImage(ImageType& image, bool isRGB, std::vector<float>& x0, std::vector<float>& x1, int threads) {
+	int rows, cols, levels;
+
+	image.getImageInfo(rows, cols, levels);
+	x0.resize((size_t)rows * cols);
+	x1.resize((size_t)rows * cols);
+
+	parallelFor(rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			featuresForPixels(isRGB, image.getRow(i), cols,
+				&x0[(size_t)i * cols], &x1[(size_t)i * cols]);
+		}
+	});
+}
@@ -0,0 +1,95 @@
+/* ColourSpace.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for converting RGB pixel values to the 2D
+ * 	colour features used by the skin models. Training and
+ * 	classification both convert through here, so they always agree.
+ *
+ * 	Features are either rg chromaticity (r/(r+g+b), g/(r+g+b), with
+ * 	black mapped to (0, 0)) or the CrCb chroma pair of YCrCb.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef COLOURSPACE_H_
+#define COLOURSPACE_H_
+
+#include <vector>
+
+#include "image.h"
+
+// Weights of red, green and blue in each YCrCb feature
+const double yccWeights[2][3] = { { 0.500, -0.419, -0.081 },
+	{ -0.169, -0.0332, 0.500 } };
+
+/* featuresForPixel():
+ * 	Converts one pixel value to its colour features.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * 	@x0: Location to store the first feature.
+ * 	@x1: Location to store the second feature.
+ * return:
+ * 	void
+ */
+inline void featuresForPixel(bool isRGB, int r, int g, int b, float& x0, float& x1);
+
+
+/* featuresForPixels():
+ * 	Converts a span of interleaved RGB values to planar features.
+ * 	Works in fixed-size chunks that the compiler turns into SIMD
+ * 	code; results match featuresForPixel() exactly.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@rgb: The interleaved values (e.g. an image row).
+ * 	@count: The number of pixels.
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * return:
+ * 	void
+ */
+void featuresForPixels(bool isRGB, const int* rgb, long count, float* x0, float* x1);
+void featuresForPixels(bool isRGB, const unsigned char* rgb, long count, float* x0, float* x1);
+
+
+/* featuresForPlanes():
+ * 	Converts a span of planar RGB values to planar features. No
+ * 	channel split is needed, so the loops vectorize directly;
+ * 	results match featuresForPixel() exactly.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@r: The red values.
+ * 	@g: The green values.
+ * 	@b: The blue values.
+ * 	@count: The number of pixels.
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * return:
+ * 	void
+ */
+void featuresForPlanes(bool isRGB, const unsigned char* r, const unsigned char* g,
+	const unsigned char* b, long count, float* x0, float* x1);
+
+
+/* featuresForImage():
+ * 	Converts a whole image to planar feature arrays, one entry per
+ * 	pixel in row order. Rows are split across threads.
+ * args:
+ * 	@image: The image to convert.
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@x0: Location to store the first feature of each pixel.
+ * 	@x1: Location to store the second feature of each pixel.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void featuresForImage(ImageType& image, bool isRGB, std::vector<float>& x0, std::vector<float>& x1, int threads = 0);
+
+#include "ColourSpace.cpp"
+
+#endif
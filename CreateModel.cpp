@@ -14,6 +14,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <time.h>
+#include <vector>
 
 #include "Eigen/Dense"
 #include "image.h"
@@ -22,13 +23,18 @@
 #include "WriteImage.h"
 #include "rgb.h"
 #include "point.h"
+#include "ColourSpace.h"
+#include "ImageCache.h"
+#include "MemoryStats.h"
+#include "PointFile.h"
 
 
 // Functions
 
 /* getImage():
  * 	Gets the pixel values from an image and stores them in an
- * 	object of type ImageType.
+ * 	object of type ImageType. Images read before are copied from
+ * 	the image cache if the file is unchanged.
  * args:
  * 	@fName: The path to the image to read.
  * 	@image: The object to store the image values to.
@@ -40,6 +46,11 @@ void getImage(char fName[], ImageType& image) {
 	int hRows, hCols, hLevel;
 	bool hType;
 
+	// Reuse an earlier decode of the same, unchanged file
+	if(cachedImage(fName, image)) {
+		return;
+	}
+
 	// Get image header
 	readImageHeader(fName, hRows, hCols, hLevel, hType);
 	ImageType tmp(hRows, hCols, hLevel);
@@ -47,6 +58,7 @@ void getImage(char fName[], ImageType& image) {
 
 	// Get image pixel values
 	readImagePPM(fName, image);
+	cacheImage(fName, image);
 }
 
 
@@ -104,14 +116,7 @@ bool learnForModel(char trainFName[], char refFName[], char modelFName[], bool t
 				//Add training values to model
 				trainData.getPixelVal(i, j/3, val);
 				float r, g;
-				if (type == true) {
-					r = (float)val.r / (val.r + val.g + val.b);
-					g = (float)val.g / (val.r + val.g + val.b);
-				}
-				else {
-					r = (0.500 * val.r) - (0.419 * val.g) - (0.081 * val.b);
-					g = - (0.169 * val.r) - (0.0332 * val.g) + (0.500 * val.b);
-				}
+				featuresForPixel(type, val.r, val.g, val.b, r, g);
 				modelFile << r << " "
 					<< g << std::endl;
 			}
@@ -274,18 +279,15 @@ void estimatePriors(char fName[], int& skinCount, int& totalCount) {
  */
 void estimate2DMean(char* fName, Eigen::Matrix<float, 2, 1>& mu1, Eigen::Matrix<float, 2, 1>& mu2) {
 	// Variables
-	std::ifstream inFile(fName);
+	PointColumns points;
 	float sum11, sum12, sum21, sum22;
-	float x, y, id;
 	int samples1, samples2;
 
-	// Test for proper file access
-	if(!inFile.is_open()) {
-		std::cout << "Error: Could not open file " << fName << std::endl;
-		exit(1);
-	}
+	// Read samples
+	loadPointColumns(fName, points);
+	reportMalformedLines(fName, points);
 
-	// Initialize variables for reading file
+	// Initialize variables for summing samples
 	sum11 = 0.0;
 	sum12 = 0.0;
 	sum21 = 0.0;
@@ -293,16 +295,16 @@ void estimate2DMean(char* fName, Eigen::Matrix<float, 2, 1>& mu1, Eigen::Matrix<
 	samples1 = 0;
 	samples2 = 0;
 
-	// Begin reading samples
-	while(inFile >> x >> y >> id) {
-		if(id == 1.0) {
-			sum11 += x;
-			sum12 += y;
+	// Begin summing samples
+	for(size_t k = 0; k < points.x.size(); k++) {
+		if(points.id[k] == 1.0) {
+			sum11 += points.x[k];
+			sum12 += points.y[k];
 			samples1++;
 		}
 		else {
-			sum21 += x;
-			sum22 += y;
+			sum21 += points.x[k];
+			sum22 += points.y[k];
 			samples2++;
 		}
 	}
@@ -337,18 +339,15 @@ void estimate2DCov(char* fName,
 		Eigen::Matrix2f& covm1, 
 		Eigen::Matrix2f& covm2) {
 	// Variables
-	std::ifstream inFile(fName);
-	float x, y, id;
+	PointColumns points;
 	float covm1_11, covm1_12, covm1_22;
 	float covm2_11, covm2_12, covm2_22;
 	float mu1x, mu1y, mu2x, mu2y;
 	int samples1, samples2;
 
-	// Test for proper file access
-	if(!inFile.is_open()) {
-		std::cout << "Error: Could not open file " << fName << std::endl;
-		exit(1);
-	}
+	// Read samples
+	loadPointColumns(fName, points);
+	reportMalformedLines(fName, points);
 
 	// Initialize values for covariance matrix
 	covm1_11 = 0.0;
@@ -364,9 +363,10 @@ void estimate2DCov(char* fName,
 	mu2x = mu2(0, 0);
 	mu2y = mu2(1, 0);
 
-	// Begin reading from file
-	while(inFile >> x >> y >> id) {
-		if(id == 1.0) {
+	// Begin going through samples
+	for(size_t k = 0; k < points.x.size(); k++) {
+		float x = points.x[k], y = points.y[k];
+		if(points.id[k] == 1.0) {
 			covm1_11 += (x - mu1x) * (x - mu1x);
 			covm1_12 += (x - mu1x) * (y - mu1y);
 			covm1_22 += (y - mu1y) * (y - mu1y);
@@ -408,38 +408,32 @@ void estimate2DCov(char* fName,
  */
 void randomDataSelect(char* fName, int count1, int count2, char* fDest) {
 	// Variables
-	float x, y, id;
 	int pos1 = 0, pos2 = 0;
-	point points1[60000];
-	point points2[140000];
-	std::ifstream inFile;
+	PointColumns points;
+	std::vector<point> points1, points2;
 	std::ofstream outFile;
 
-	// Open input file
-	inFile.open(fName);
-	if(!inFile.is_open()) {
-		std::cout << "Error: Could not access file " << fName << std::endl;
-	}
-
 	// Read in points
-	while(inFile >> x >> y >> id) {
+	loadPointColumns(fName, points);
+	reportMalformedLines(fName, points);
+	for(size_t k = 0; k < points.x.size(); k++) {
 		point p;
-		p.x = x;
-		p.y = y;
-		p.id = id;
+		p.x = points.x[k];
+		p.y = points.y[k];
+		p.id = points.id[k];
 
-		if(id == 1.0) {
-			points1[pos1] = p;
-			pos1++;
+		if(points.id[k] == 1.0) {
+			points1.push_back(p);
 		}
 		else {
-			points2[pos2] = p;
-			pos2++;
+			points2.push_back(p);
 		}
 	}
-
-	// Close input file
-	inFile.close();
+	trackAlloc(MEMORY_DATASET, (points1.capacity() + points2.capacity()) * sizeof(point));
+	if((count1 > 0 && points1.empty()) || (count2 > 0 && points2.empty())) {
+		std::cout << "Error: No points of a class in " << fName << std::endl;
+		exit(1);
+	}
 
 	// Open output file
 	outFile.open(fDest);
@@ -450,18 +444,18 @@ void randomDataSelect(char* fName, int count1, int count2, char* fDest) {
 	// Randomly select data
 	std::srand(time(NULL));
 	for(int i = 0; i < count1; i++) {
-		pos1 = std::rand() % 60001;
+		pos1 = std::rand() % points1.size();
 		point p = points1[pos1];
 		outFile << p.x << " " << p.y << " " << p.id << std::endl;
 	}
 
 	for(int i = 0; i < count2; i++) {
-		pos2 = std::rand() % 140001;
+		pos2 = std::rand() % points2.size();
 		point p = points2[pos2];
 		outFile << p.x << " " << p.y << " " << p.id << std::endl;
 	}
 
 	// Close output file
 	outFile.close();
-	
+	trackFree(MEMORY_DATASET, (points1.capacity() + points2.capacity()) * sizeof(point));
 }
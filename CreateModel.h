@@ -3,7 +3,8 @@
 
 /* getImage():
  * 	Gets the pixel values from an image and stores them in an
- * 	object of type ImageType.
+ * 	object of type ImageType. Images read before are copied from
+ * 	the image cache if the file is unchanged.
  * args:
  * 	@fName: The path to the image to read.
  * 	@image: The object to store the image values to.
@@ -0,0 +1,227 @@
+/* CrossValidate.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for k-fold cross-validation from fold statistics.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+#include "image.h"
+#include "CrossValidate.h"
+#include "CreateModel.h"
+#include "ModelEval.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+#include "PointFile.h"
+#include "SkinModel.h"
+
+
+// Functions
+
+/* classModelForStats():
+ * 	Builds the Gaussian of one point class from its statistics.
+ * 	The log of the prior is kept in the threshold, to be added to
+ * 	the class's score.
+ * args:
+ * 	@stats: The statistics of the class.
+ * 	@prior: The prior probability of the class.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void classModelForStats(const FeatureStats& stats, double prior, SkinModel& model) {
+	if(stats.n < 2) {
+		std::cout << "Error: Too few points in a class to build a model" << std::endl;
+		exit(1);
+	}
+
+	model.isRGB = true;
+	model.prior = prior;
+	meanCovForStats(stats, model.mu, model.cov);
+	model.t = log(prior);
+	prepareSkinModel(model);
+}
+
+
+/* crossValidatePoints():
+ * 	Cross-validates the two-class Gaussian classifier (separate
+ * 	covariances, priors from the training counts) on labelled
+ * 	points. Points are dealt into folds after a seeded shuffle.
+ * 	Folds are tested on separate threads.
+ * args:
+ * 	@points: The points (labels 1 and 2).
+ * 	@folds: The number of folds (at least 2).
+ * 	@seed: The seed of the shuffle.
+ * 	@results: Location to store the results of each fold.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void crossValidatePoints(const PointColumns& points, int folds, unsigned seed,
+	std::vector<PointFoldResult>& results, int threads) {
+	size_t count = points.x.size();
+
+	if(folds < 2 || (size_t)folds > count) {
+		std::cout << "Error: Fold count must be from 2 to the number of points" << std::endl;
+		exit(1);
+	}
+
+	// Deal shuffled points into folds
+	std::vector<size_t> order(count);
+	for(size_t k = 0; k < count; k++) {
+		order[k] = k;
+	}
+	std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+	std::vector<std::vector<size_t> > members(folds);
+	for(size_t k = 0; k < count; k++) {
+		members[k % folds].push_back(order[k]);
+	}
+
+	// Gather statistics of each fold, then the total
+	std::vector<FeatureStats> stats(folds * 2);
+	FeatureStats total[2];
+	clearFeatureStats(total[0]);
+	clearFeatureStats(total[1]);
+	for(int f = 0; f < folds; f++) {
+		clearFeatureStats(stats[f*2]);
+		clearFeatureStats(stats[f*2+1]);
+		for(size_t k = 0; k < members[f].size(); k++) {
+			size_t p = members[f][k];
+			int c = points.id[p] == 2 ? 1 : 0;
+			addFeatureSample(stats[f*2+c], points.x[p], points.y[p]);
+		}
+		mergeFeatureStats(total[0], stats[f*2]);
+		mergeFeatureStats(total[1], stats[f*2+1]);
+	}
+
+	// Train on the total less each fold, and test on the fold
+	results.resize(folds);
+	parallelFor(folds, threads, [&](int begin, int end) {
+		for(int f = begin; f < end; f++) {
+			FeatureStats train[2] = { total[0], total[1] };
+			SkinModel model[2];
+			PointFoldResult& result = results[f];
+
+			mergeFeatureStats(train[0], stats[f*2], -1);
+			mergeFeatureStats(train[1], stats[f*2+1], -1);
+			for(int c = 0; c < 2; c++) {
+				classModelForStats(train[c], train[c].n / (train[0].n + train[1].n), model[c]);
+				result.tested[c] = stats[f*2+c].n;
+				result.misclass[c] = 0;
+			}
+
+			for(size_t k = 0; k < members[f].size(); k++) {
+				size_t p = members[f][k];
+				int c = points.id[p] == 2 ? 1 : 0;
+				float g1 = scoreForFeatures(points.x[p], points.y[p], model[0]) + model[0].t;
+				float g2 = scoreForFeatures(points.x[p], points.y[p], model[1]) + model[1].t;
+				int chosen = g1 < g2 ? 1 : 0;
+				result.misclass[c] += chosen != c;
+			}
+		}
+	});
+}
+
+
+/* crossValidateImages():
+ * 	Cross-validates the rg and YCrCb skin models on image pairs,
+ * 	holding out whole images. Image k goes to fold k % folds. Each
+ * 	image is decoded once to gather statistics and once more when
+ * 	its fold is tested; folds are tested on separate threads.
+ * args:
+ * 	@trainFNames: The paths of the training images.
+ * 	@refFNames: The paths of the matching reference images.
+ * 	@count: The number of image pairs.
+ * 	@folds: The number of folds (2 to count).
+ * 	@t: The threshold of each colour scheme (1=RGB, 0=YCrCb).
+ * 	@results: Location to store the results of each fold.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void crossValidateImages(char* trainFNames[], char* refFNames[], int count, int folds,
+	const float t[2], std::vector<ImageFoldResult>& results, int threads) {
+	if(folds < 2 || folds > count) {
+		std::cout << "Error: Fold count must be from 2 to the number of images" << std::endl;
+		exit(1);
+	}
+
+	// Gather statistics of each fold, then the total
+	std::vector<ImageStats> stats(folds);
+	ImageStats total;
+	for(int f = 0; f < folds; f++) {
+		clearImageStats(stats[f]);
+	}
+	for(int k = 0; k < count; k++) {
+		ImageType train, ref;
+		ImageStats pair;
+		ImageStats& fold = stats[k % folds];
+
+		getImage(trainFNames[k], train);
+		getImage(refFNames[k], ref);
+		statsForImages(train, ref, pair, threads);
+
+		fold.skinCount += pair.skinCount;
+		fold.totalCount += pair.totalCount;
+		for(int c = 0; c < 2; c++) {
+			mergeFeatureStats(fold.skin[c], pair.skin[c]);
+			mergeFeatureStats(fold.other[c], pair.other[c]);
+		}
+	}
+
+	clearImageStats(total);
+	for(int f = 0; f < folds; f++) {
+		total.skinCount += stats[f].skinCount;
+		total.totalCount += stats[f].totalCount;
+		for(int c = 0; c < 2; c++) {
+			mergeFeatureStats(total.skin[c], stats[f].skin[c]);
+			mergeFeatureStats(total.other[c], stats[f].other[c]);
+		}
+	}
+
+	// Train on the total less each fold, and test on the fold's images
+	results.resize(folds);
+	parallelFor(folds, threads, [&](int begin, int end) {
+		for(int f = begin; f < end; f++) {
+			ImageStats train = total;
+			std::vector<ModelEvaluation> evals(2);
+
+			train.skinCount -= stats[f].skinCount;
+			train.totalCount -= stats[f].totalCount;
+			for(int c = 0; c < 2; c++) {
+				SkinModel model;
+
+				mergeFeatureStats(train.skin[c], stats[f].skin[c], -1);
+				mergeFeatureStats(train.other[c], stats[f].other[c], -1);
+				modelForStats(train, c == 1, t[c], model);
+				prepareModelEvaluation(model, std::vector<float>(1, t[c]), evals[c]);
+			}
+
+			results[f].images = 0;
+			for(int k = f; k < count; k += folds) {
+				ImageType image, ref;
+
+				getImage(trainFNames[k], image);
+				getImage(refFNames[k], ref);
+				evaluateModels(image, &ref, evals, 1);
+				results[f].images++;
+			}
+			for(int c = 0; c < 2; c++) {
+				results[f].counts[c] = evals[c].counts[0];
+			}
+		}
+	});
+}
@@ -0,0 +1,98 @@
+/* CrossValidate.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for k-fold cross-validation of the Gaussian
+ * 	classifiers, on labelled points and on skin image pairs.
+ *
+ * 	The sufficient statistics of every fold are gathered in one
+ * 	pass. Each fold's training statistics are the total less the
+ * 	fold's own, so no fold retrains from the samples.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef CROSSVALIDATE_H_
+#define CROSSVALIDATE_H_
+
+#include <vector>
+
+#include "ModelEval.h"
+#include "ModelStats.h"
+#include "PointFile.h"
+#include "SkinModel.h"
+
+/* PointFoldResult:
+ * 	Results of testing one fold of labelled points.
+ */
+struct PointFoldResult {
+	long tested[2];      // tested: Points of class 1 and 2 in the fold.
+	long misclass[2];    // misclass: Points of class 1 and 2 classified wrongly.
+};
+
+/* ImageFoldResult:
+ * 	Results of testing one fold of image pairs. Arrays of two are
+ * 	indexed by colour scheme (1=RGB, 0=YCrCb).
+ */
+struct ImageFoldResult {
+	int images;                  // images: Image pairs in the fold.
+	ConfusionMatrix counts[2];   // counts: Pixel results of each colour scheme.
+};
+
+
+/* classModelForStats():
+ * 	Builds the Gaussian of one point class from its statistics.
+ * 	The log of the prior is kept in the threshold, to be added to
+ * 	the class's score.
+ * args:
+ * 	@stats: The statistics of the class.
+ * 	@prior: The prior probability of the class.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void classModelForStats(const FeatureStats& stats, double prior, SkinModel& model);
+
+
+/* crossValidatePoints():
+ * 	Cross-validates the two-class Gaussian classifier (separate
+ * 	covariances, priors from the training counts) on labelled
+ * 	points. Points are dealt into folds after a seeded shuffle.
+ * 	Folds are tested on separate threads.
+ * args:
+ * 	@points: The points (labels 1 and 2).
+ * 	@folds: The number of folds (at least 2).
+ * 	@seed: The seed of the shuffle.
+ * 	@results: Location to store the results of each fold.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void crossValidatePoints(const PointColumns& points, int folds, unsigned seed,
+	std::vector<PointFoldResult>& results, int threads = 0);
+
+
+/* crossValidateImages():
+ * 	Cross-validates the rg and YCrCb skin models on image pairs,
+ * 	holding out whole images. Image k goes to fold k % folds. Each
+ * 	image is decoded once to gather statistics and once more when
+ * 	its fold is tested; folds are tested on separate threads.
+ * args:
+ * 	@trainFNames: The paths of the training images.
+ * 	@refFNames: The paths of the matching reference images.
+ * 	@count: The number of image pairs.
+ * 	@folds: The number of folds (2 to count).
+ * 	@t: The threshold of each colour scheme (1=RGB, 0=YCrCb).
+ * 	@results: Location to store the results of each fold.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void crossValidateImages(char* trainFNames[], char* refFNames[], int count, int folds,
+	const float t[2], std::vector<ImageFoldResult>& results, int threads = 0);
+
+#include "CrossValidate.cpp"
+
+#endif
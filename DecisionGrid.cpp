@@ -0,0 +1,189 @@
+/* DecisionGrid.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for classifying points with a decision grid.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <iostream>
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+#include "DecisionGrid.h"
+#include "Eigen/Dense"
+#include "Parallel.h"
+
+
+// Functions
+
+/* classForPointExact():
+ * 	Scores a point under both classes, as bayesCaseThree() does.
+ * args:
+ * 	@x: The point.
+ * 	@muOne, @muTwo: Mean of each class.
+ * 	@sigmaOne, @sigmaTwo: Covariance of each class.
+ * 	@priorOne, @priorTwo: Prior probability of each class.
+ * return:
+ * 	int: The chosen class (1 or 2).
+ */
+int classForPointExact(const Eigen::Vector2f& x, const Eigen::Vector2f& muOne,
+	const Eigen::Vector2f& muTwo, const Eigen::Matrix2f& sigmaOne,
+	const Eigen::Matrix2f& sigmaTwo, float priorOne, float priorTwo) {
+	float discrimOne = (x.transpose() * (-0.5 * sigmaOne.inverse()) * x) + ((sigmaOne.inverse() * muOne).transpose() * x)(0) +(-0.5 * muOne.transpose() * sigmaOne.inverse() * muOne) + (-0.5 * log(sigmaOne.determinant()));
+	float discrimTwo = (x.transpose() * (-0.5 * sigmaTwo.inverse()) * x) + ((sigmaTwo.inverse() * muTwo).transpose() * x)(0) +(-0.5 * muTwo.transpose() * sigmaTwo.inverse() * muTwo) + (-0.5 * log(sigmaTwo.determinant()));
+
+	if (priorOne != priorTwo) {
+		discrimOne += log(priorOne);
+		discrimTwo += log(priorTwo);
+	}
+
+	return discrimOne < discrimTwo ? 2 : 1;
+}
+
+
+/* buildDecisionGrid():
+ * 	Decides the class of every cell of a grid over a box. A cell is
+ * 	decided when a bound on the change of the discriminant across
+ * 	it is below its value at the centre. Rows of cells are split
+ * 	across threads.
+ * args:
+ * 	@muOne, @muTwo: Mean of each class.
+ * 	@sigmaOne, @sigmaTwo: Covariance of each class.
+ * 	@priorOne, @priorTwo: Prior probability of each class.
+ * 	@xMin, @xMax, @yMin, @yMax: The box to cover.
+ * 	@resolution: Cells along each side of the box.
+ * 	@grid: Location to store the grid.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void buildDecisionGrid(const Eigen::Vector2f& muOne, const Eigen::Vector2f& muTwo,
+	const Eigen::Matrix2f& sigmaOne, const Eigen::Matrix2f& sigmaTwo,
+	float priorOne, float priorTwo, float xMin, float xMax, float yMin, float yMax,
+	int resolution, DecisionGrid& grid, int threads) {
+	// Discriminant of each class as -0.5 x'Px + q'x + r, in double
+	double p[2][2][2], q[2][2], r[2];
+
+	if(resolution < 1) {
+		std::cout << "Error: Grid resolution must be positive" << std::endl;
+		exit(1);
+	}
+
+	grid.mu[0] = muOne;
+	grid.mu[1] = muTwo;
+	grid.sigma[0] = sigmaOne;
+	grid.sigma[1] = sigmaTwo;
+	grid.prior[0] = priorOne;
+	grid.prior[1] = priorTwo;
+	for(int c = 0; c < 2; c++) {
+		Eigen::Matrix2f inv = grid.sigma[c].inverse();
+		for(int i = 0; i < 2; i++) {
+			for(int j = 0; j < 2; j++) {
+				p[c][i][j] = 0.5 * ((double)inv(i, j) + inv(j, i));
+			}
+		}
+		for(int i = 0; i < 2; i++) {
+			q[c][i] = p[c][i][0] * grid.mu[c](0) + p[c][i][1] * grid.mu[c](1);
+		}
+		r[c] = -0.5 * (q[c][0] * grid.mu[c](0) + q[c][1] * grid.mu[c](1))
+			- 0.5 * log((double)grid.sigma[c].determinant());
+		if(priorOne != priorTwo) {
+			r[c] += log((double)grid.prior[c]);
+		}
+	}
+
+	// The difference d = g1 - g2 has constant second derivatives
+	double h00 = p[1][0][0] - p[0][0][0];
+	double h01 = p[1][0][1] - p[0][0][1];
+	double h11 = p[1][1][1] - p[0][1][1];
+
+	grid.xMin = xMin;
+	grid.yMin = yMin;
+	grid.cols = resolution;
+	grid.rows = resolution;
+	grid.cellWidth = (xMax - xMin) / resolution;
+	grid.cellHeight = (yMax - yMin) / resolution;
+	if(!(grid.cellWidth > 0) || !(grid.cellHeight > 0)) {
+		grid.cellWidth = grid.cellWidth > 0 ? grid.cellWidth : 1;
+		grid.cellHeight = grid.cellHeight > 0 ? grid.cellHeight : 1;
+	}
+	grid.cells.assign((size_t)grid.rows * grid.cols, GRID_BOUNDARY);
+
+	// Half a cell, grown so points rounded into a neighbour are covered
+	double hx = 0.51 * grid.cellWidth, hy = 0.51 * grid.cellHeight;
+
+	std::vector<long> boundary(grid.rows, 0);
+	parallelFor(grid.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			double cy = grid.yMin + (i + 0.5) * grid.cellHeight;
+			for(int j = 0; j < grid.cols; j++) {
+				double cx = grid.xMin + (j + 0.5) * grid.cellWidth;
+				double d = 0, gx = 0, gy = 0, scale = 0;
+				double ax = fabs(cx) + hx, ay = fabs(cy) + hy;
+
+				for(int c = 0; c < 2; c++) {
+					double sign = c == 0 ? 1 : -1;
+					double px = p[c][0][0] * cx + p[c][0][1] * cy;
+					double py = p[c][1][0] * cx + p[c][1][1] * cy;
+
+					d += sign * (-0.5 * (cx * px + cy * py) + q[c][0] * cx + q[c][1] * cy + r[c]);
+					gx += sign * (q[c][0] - px);
+					gy += sign * (q[c][1] - py);
+
+					// Size of the terms, for the rounding of float scoring
+					scale += 0.5 * (fabs(p[c][0][0]) * ax * ax + 2 * fabs(p[c][0][1]) * ax * ay
+						+ fabs(p[c][1][1]) * ay * ay)
+						+ fabs(q[c][0]) * ax + fabs(q[c][1]) * ay + fabs(r[c])
+						+ 0.5 * fabs(q[c][0] * grid.mu[c](0) + q[c][1] * grid.mu[c](1));
+				}
+
+				double bound = fabs(gx) * hx + fabs(gy) * hy
+					+ 0.5 * (fabs(h00) * hx * hx + 2 * fabs(h01) * hx * hy + fabs(h11) * hy * hy);
+				unsigned char& cell = grid.cells[(size_t)i * grid.cols + j];
+				if(fabs(d) > bound + 1e-4 * scale) {
+					cell = d > 0 ? GRID_CLASS_ONE : GRID_CLASS_TWO;
+				}
+				else {
+					boundary[i]++;
+				}
+			}
+		}
+	});
+
+	grid.boundaryCells = 0;
+	for(int i = 0; i < grid.rows; i++) {
+		grid.boundaryCells += boundary[i];
+	}
+}
+
+
+/* classForGrid():
+ * 	Classifies a point, scoring it exactly only when its cell is
+ * 	not decided.
+ * args:
+ * 	@grid: The grid.
+ * 	@x, @y: The point.
+ * return:
+ * 	int: The chosen class (1 or 2).
+ */
+inline int classForGrid(const DecisionGrid& grid, float x, float y) {
+	double u = ((double)x - grid.xMin) / grid.cellWidth;
+	double v = ((double)y - grid.yMin) / grid.cellHeight;
+
+	if(u >= 0 && v >= 0 && u < grid.cols && v < grid.rows) {
+		unsigned char cell = grid.cells[(size_t)v * grid.cols + (size_t)u];
+		if(cell != GRID_BOUNDARY) {
+			return cell;
+		}
+	}
+
+	return classForPointExact(Eigen::Vector2f(x, y), grid.mu[0], grid.mu[1],
+		grid.sigma[0], grid.sigma[1], grid.prior[0], grid.prior[1]);
+}
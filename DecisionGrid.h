@@ -0,0 +1,94 @@
+/* DecisionGrid.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for classifying 2D points between two Gaussian
+ * 	classes (separate covariances) with a precomputed grid.
+ *
+ * 	The grid covers a bounding box. A cell that lies wholly on one
+ * 	side of the decision boundary stores its class; only points in
+ * 	cells the boundary may cross, or outside the box, are scored
+ * 	exactly. The answers match exact scoring for every point.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef DECISIONGRID_H_
+#define DECISIONGRID_H_
+
+#include <vector>
+
+#include "Eigen/Dense"
+
+#define GRID_BOUNDARY 0
+#define GRID_CLASS_ONE 1
+#define GRID_CLASS_TWO 2
+
+/* DecisionGrid:
+ * 	The two class models and the decided class of each grid cell.
+ */
+struct DecisionGrid {
+	Eigen::Vector2f mu[2];             // mu: Mean of each class.
+	Eigen::Matrix2f sigma[2];          // sigma: Covariance of each class.
+	float prior[2];                    // prior: Prior probability of each class.
+	float xMin, yMin;                  // xMin, yMin: Corner of the box.
+	float cellWidth, cellHeight;       // cellWidth, cellHeight: Size of a cell.
+	int cols, rows;                    // cols, rows: Cells across and down the box.
+	std::vector<unsigned char> cells;  // cells: Class of each cell, or GRID_BOUNDARY.
+	long boundaryCells;                // boundaryCells: Cells left to exact scoring.
+};
+
+
+/* classForPointExact():
+ * 	Scores a point under both classes, as bayesCaseThree() does.
+ * args:
+ * 	@x: The point.
+ * 	@muOne, @muTwo: Mean of each class.
+ * 	@sigmaOne, @sigmaTwo: Covariance of each class.
+ * 	@priorOne, @priorTwo: Prior probability of each class.
+ * return:
+ * 	int: The chosen class (1 or 2).
+ */
+int classForPointExact(const Eigen::Vector2f& x, const Eigen::Vector2f& muOne,
+	const Eigen::Vector2f& muTwo, const Eigen::Matrix2f& sigmaOne,
+	const Eigen::Matrix2f& sigmaTwo, float priorOne, float priorTwo);
+
+
+/* buildDecisionGrid():
+ * 	Decides the class of every cell of a grid over a box. A cell is
+ * 	decided when a bound on the change of the discriminant across
+ * 	it is below its value at the centre. Rows of cells are split
+ * 	across threads.
+ * args:
+ * 	@muOne, @muTwo: Mean of each class.
+ * 	@sigmaOne, @sigmaTwo: Covariance of each class.
+ * 	@priorOne, @priorTwo: Prior probability of each class.
+ * 	@xMin, @xMax, @yMin, @yMax: The box to cover.
+ * 	@resolution: Cells along each side of the box.
+ * 	@grid: Location to store the grid.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void buildDecisionGrid(const Eigen::Vector2f& muOne, const Eigen::Vector2f& muTwo,
+	const Eigen::Matrix2f& sigmaOne, const Eigen::Matrix2f& sigmaTwo,
+	float priorOne, float priorTwo, float xMin, float xMax, float yMin, float yMax,
+	int resolution, DecisionGrid& grid, int threads = 0);
+
+
+/* classForGrid():
+ * 	Classifies a point, scoring it exactly only when its cell is
+ * 	not decided.
+ * args:
+ * 	@grid: The grid.
+ * 	@x, @y: The point.
+ * return:
+ * 	int: The chosen class (1 or 2).
+ */
+inline int classForGrid(const DecisionGrid& grid, float x, float y);
+
+#include "DecisionGrid.cpp"
+
+#endif
@@ -0,0 +1,49 @@
+/* ExperimentModels.h:
+ * 	Skin models as compile-time constants.
+ * 	Generated by `main export-header`; do not edit.
+ */
+
+#ifndef EXPERIMENTMODELS_H_
+#define EXPERIMENTMODELS_H_
+
+struct RGBSkinModel {
+	static constexpr bool isRGB = true;
+	static constexpr float prior = 0.0671454966f;
+	static constexpr float mu0 = 0.432222992f;
+	static constexpr float mu1 = 0.295771986f;
+	static constexpr float cov00 = 0.0024331701f;
+	static constexpr float cov01 = -0.00111724995f;
+	static constexpr float cov10 = -0.00111724995f;
+	static constexpr float cov11 = 0.000788423f;
+	static constexpr float t = 6.75252008f;
+	static constexpr float inv00 = 1176.54053f;
+	static constexpr float inv01 = 1667.23938f;
+	static constexpr float inv10 = 1667.23938f;
+	static constexpr float inv11 = 3630.94849f;
+	static constexpr float invMu0 = 1001.65057f;
+	static constexpr float invMu1 = 1794.552f;
+	static constexpr float bias = -474.74939f;
+	static constexpr float logDet = -14.2158089f;
+};
+
+struct YCCSkinModel {
+	static constexpr bool isRGB = false;
+	static constexpr float prior = 0.0671454966f;
+	static constexpr float mu0 = 23.6389999f;
+	static constexpr float mu1 = 22.2348995f;
+	static constexpr float cov00 = 48.9501991f;
+	static constexpr float cov01 = -0.328258008f;
+	static constexpr float cov10 = -0.328258008f;
+	static constexpr float cov11 = 176.884003f;
+	static constexpr float t = -5.21310997f;
+	static constexpr float inv00 = 0.0204291809f;
+	static constexpr float inv01 = 3.79120902e-05f;
+	static constexpr float inv10 = 3.79120902e-05f;
+	static constexpr float inv11 = 0.00565349311f;
+	static constexpr float invMu0 = 0.483768374f;
+	static constexpr float invMu1 = 0.126601055f;
+	static constexpr float bias = -11.6585236f;
+	static constexpr float logDet = 9.06628513f;
+};
+
+#endif
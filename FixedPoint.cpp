@@ -0,0 +1,200 @@
+/* FixedPoint.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for classifying skin pixels with integer arithmetic
+ * 	only.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <math.h>
+
+#include "image.h"
+#include "rgb.h"
+#include "SkinModel.h"
+#include "FixedPoint.h"
+#include "ColourSpace.h"
+#include "Parallel.h"
+
+
+// Functions
+
+/* prepareFixedSkinModel():
+ * 	Converts a model and its threshold to integers.
+ * args:
+ * 	@model: The model to convert.
+ * 	@fixed: Location to store the converted model.
+ * return:
+ * 	void
+ */
+void prepareFixedSkinModel(const SkinModel& model, FixedSkinModel& fixed) {
+	// Features in [0,1] for rg, within +/-128 for YCrCb
+	fixed.isRGB = model.isRGB;
+	fixed.fracBits = model.isRGB ? 14 : 6;
+	double one = (double)(1 << fixed.fracBits);
+
+	fixed.mu[0] = (int32_t)lround(model.mu[0] * one);
+	fixed.mu[1] = (int32_t)lround(model.mu[1] * one);
+
+	// Scale A so its largest entry (off-diagonals summed) fits 16 bits
+	double a00 = model.inv[0][0];
+	double a01 = (double)model.inv[0][1] + model.inv[1][0];
+	double a11 = model.inv[1][1];
+	double largest = fmax(fabs(a00), fmax(fabs(a01), fabs(a11)));
+	int shift = 14 - (int)ceil(log2(largest));
+	double scale = ldexp(1.0, shift);
+
+	fixed.a00 = (int32_t)lround(a00 * scale);
+	fixed.a01 = (int32_t)lround(a01 * scale);
+	fixed.a11 = (int32_t)lround(a11 * scale);
+
+	// score = -0.5 * d^T A d - 0.5 * log|cov|, so skin when
+	// d^T A d < -2t - log|cov|
+	double det = (double)model.cov[0][0] * model.cov[1][1]
+		- (double)model.cov[0][1] * model.cov[1][0];
+	double bound = -2.0 * model.t - log(det);
+	fixed.never = bound <= 0;
+	fixed.limit = fixed.never ? 0 : (int64_t)ceil(bound * scale * one * one);
+
+	// YCrCb weights
+	for(int i = 0; i < 2; i++) {
+		for(int j = 0; j < 3; j++) {
+			fixed.coef[i][j] = (int32_t)lround(yccWeights[i][j] * one * 1024);
+		}
+	}
+
+	// Reciprocals of channel sums
+	fixed.recip[0] = 0;
+	for(int s = 1; s <= 765; s++) {
+		fixed.recip[s] = (uint32_t)lround(16777216.0 / s);
+	}
+}
+
+
+/* classifyForPixelFixed():
+ * 	Classifies a pixel value as either skin or not skin.
+ * args:
+ * 	@r: Red value (0-255).
+ * 	@g: Green value (0-255).
+ * 	@b: Blue value (0-255).
+ * 	@fixed: The converted model to classify with.
+ * return:
+ * 	true: if the pixel is classified as skin.
+ * 	false: otherwise.
+ */
+bool classifyForPixelFixed(int r, int g, int b, const FixedSkinModel& fixed) {
+	int32_t x0, x1;
+
+	// Calculate pixel feature values
+	if(fixed.isRGB) {
+		int drop = 24 - fixed.fracBits;
+		uint32_t recip = fixed.recip[r + g + b];
+		x0 = (int32_t)(((uint32_t)r * recip + (1u << (drop - 1))) >> drop);
+		x1 = (int32_t)(((uint32_t)g * recip + (1u << (drop - 1))) >> drop);
+	}
+	else {
+		x0 = (fixed.coef[0][0] * r + fixed.coef[0][1] * g + fixed.coef[0][2] * b + 512) >> 10;
+		x1 = (fixed.coef[1][0] * r + fixed.coef[1][1] * g + fixed.coef[1][2] * b + 512) >> 10;
+	}
+
+	// Calculate squared distance from mean
+	int32_t d0 = x0 - fixed.mu[0];
+	int32_t d1 = x1 - fixed.mu[1];
+	int32_t u = fixed.a00 * d0 + fixed.a01 * d1;
+	int32_t v = fixed.a11 * d1;
+	int64_t dist = (int64_t)u * d0 + (int64_t)v * d1;
+
+	return !fixed.never && dist < fixed.limit;
+}
+
+
+/* classifyForImageFixed():
+ * 	Classifies skin pixels within an image.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@fixed: The converted model to classify with.
+ * return:
+ * 	void
+ */
+void classifyForImageFixed(ImageType& source, ImageType& dest, const FixedSkinModel& fixed) {
+	// Variables
+	int rows, cols, levels;
+
+	// Get image metadata
+	source.getImageInfo(rows, cols, levels);
+
+	// Loop through source image pixels in the bands they were allocated in
+	parallelFor(rows, imageBands(rows, cols), [&](int begin, int end) {
+		RGB val;
+
+		for(int i = begin; i < end; i++) {
+			for(int j = 0; j < cols; j++) {
+				source.getPixelVal(i, j, val);
+
+				// Output classification to destination image
+				int level = classifyForPixelFixed(val.r, val.g, val.b, fixed) ? 255 : 0;
+				val.r = level;
+				val.g = level;
+				val.b = level;
+				dest.setPixelVal(i, j, val);
+			}
+		}
+	});
+}
+
+
+/* classifyForBufferFixed():
+ * 	Classifies skin pixels within raw 8-bit interleaved RGB values.
+ * args:
+ * 	@pixels: The RGB values to classify, row by row.
+ * 	@count: The number of pixels.
+ * 	@fixed: The converted model to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForBufferFixed(const unsigned char* pixels, long count, const FixedSkinModel& fixed, unsigned char* mask) {
+	for(long k = 0; k < count; k++) {
+		mask[k] = classifyForPixelFixed(pixels[k*3], pixels[k*3+1],
+			pixels[k*3+2], fixed) ? 255 : 0;
+	}
+}
+
+
+/* compareFixedSkinModel():
+ * 	Classifies every 8-bit RGB colour with both the float and the
+ * 	fixed-point path and measures where they disagree.
+ * args:
+ * 	@model: The float model (with threshold).
+ * 	@fixed: The same model converted to integers.
+ * 	@disagree: Location to store the number of colours that differ.
+ * 	@maxGap: Location to store the largest |score - t| among them.
+ * return:
+ * 	void
+ */
+void compareFixedSkinModel(const SkinModel& model, const FixedSkinModel& fixed, long& disagree, float& maxGap) {
+	RGB val;
+
+	disagree = 0;
+	maxGap = 0;
+	for(int r = 0; r < 256; r++) {
+		for(int g = 0; g < 256; g++) {
+			for(int b = 0; b < 256; b++) {
+				val.r = r;
+				val.g = g;
+				val.b = b;
+				float score = scoreForPixel(val, model);
+				if((score > model.t) != classifyForPixelFixed(r, g, b, fixed)) {
+					disagree++;
+					maxGap = fmax(maxGap, fabs(score - model.t));
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,118 @@
+/* FixedPoint.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for classifying skin pixels with integer
+ * 	arithmetic only.
+ *
+ * 	Skin is decided by the squared Mahalanobis distance d^T A d of
+ * 	the features from the mean, where A is the inverse covariance
+ * 	matrix. Features are held with F fraction bits (14 for rg, 6 for
+ * 	YCrCb) so offsets from the mean fit in 16 bits, A is scaled to fit
+ * 	in 16 bits, and the distance is summed in 64 bits. Chromaticity
+ * 	uses a table of 2^24 / (r+g+b) for every channel sum 0..765, so
+ * 	no division is done per pixel.
+ *
+ * 	Bound on disagreement: rounding moves each feature by at most
+ * 	2^-(F+1) plus under 2^-16 from the table, and A by at most half a unit
+ * 	of its scale. Only pixels whose float score lies very close to the
+ * 	threshold can change side. compareFixedSkinModel() checks all
+ * 	2^24 colours and reports the exact count and the widest score gap.
+ * 	For the experiment models, at their thresholds:
+ * 		rg:    276 of 16777216 colours differ, all within 0.0028 of t.
+ * 		YCrCb: 290 of 16777216 colours differ, all within 0.0015 of t.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef FIXEDPOINT_H_
+#define FIXEDPOINT_H_
+
+#include <stdint.h>
+
+#include "image.h"
+#include "SkinModel.h"
+
+/* FixedSkinModel:
+ * 	A skin model converted to integers for one threshold.
+ */
+struct FixedSkinModel {
+	bool isRGB;              // isRGB: Colour scheme (1=RGB, 0=YCrCb).
+	bool never;              // never: Threshold is above every score.
+	int fracBits;            // fracBits: Fraction bits of features.
+	int32_t mu[2];           // mu: Mean of the features.
+	int32_t a00, a01, a11;   // a00, a01, a11: Scaled A; a01 holds both off-diagonals.
+	int64_t limit;           // limit: Skin if d^T A d is below this.
+	int32_t coef[2][3];      // coef: YCrCb weights with 10 more fraction bits.
+	uint32_t recip[766];     // recip: 2^24 / sum for every channel sum.
+};
+
+
+/* prepareFixedSkinModel():
+ * 	Converts a model and its threshold to integers.
+ * args:
+ * 	@model: The model to convert.
+ * 	@fixed: Location to store the converted model.
+ * return:
+ * 	void
+ */
+void prepareFixedSkinModel(const SkinModel& model, FixedSkinModel& fixed);
+
+
+/* classifyForPixelFixed():
+ * 	Classifies a pixel value as either skin or not skin.
+ * args:
+ * 	@r: Red value (0-255).
+ * 	@g: Green value (0-255).
+ * 	@b: Blue value (0-255).
+ * 	@fixed: The converted model to classify with.
+ * return:
+ * 	true: if the pixel is classified as skin.
+ * 	false: otherwise.
+ */
+bool classifyForPixelFixed(int r, int g, int b, const FixedSkinModel& fixed);
+
+
+/* classifyForImageFixed():
+ * 	Classifies skin pixels within an image.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@fixed: The converted model to classify with.
+ * return:
+ * 	void
+ */
+void classifyForImageFixed(ImageType& source, ImageType& dest, const FixedSkinModel& fixed);
+
+
+/* classifyForBufferFixed():
+ * 	Classifies skin pixels within raw 8-bit interleaved RGB values.
+ * args:
+ * 	@pixels: The RGB values to classify, row by row.
+ * 	@count: The number of pixels.
+ * 	@fixed: The converted model to classify with.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void classifyForBufferFixed(const unsigned char* pixels, long count, const FixedSkinModel& fixed, unsigned char* mask);
+
+
+/* compareFixedSkinModel():
+ * 	Classifies every 8-bit RGB colour with both the float and the
+ * 	fixed-point path and measures where they disagree.
+ * args:
+ * 	@model: The float model (with threshold).
+ * 	@fixed: The same model converted to integers.
+ * 	@disagree: Location to store the number of colours that differ.
+ * 	@maxGap: Location to store the largest |score - t| among them.
+ * return:
+ * 	void
+ */
+void compareFixedSkinModel(const SkinModel& model, const FixedSkinModel& fixed, long& disagree, float& maxGap);
+
+#include "FixedPoint.cpp"
+
+#endif
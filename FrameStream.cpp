@@ -0,0 +1,513 @@
+/* FrameStream.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for classifying a sequence of frames read from a
+ * 	file or pipe.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <atomic>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "FrameStream.h"
+#include "ColourSpace.h"
+#include "SkinModel.h"
+#include "SkinRegion.h"
+#include "Parallel.h"
+#include "WriteImage.h"
+
+#define STREAM_MAX_PIXELS (64L << 20)   // Largest frame accepted.
+
+
+// Functions
+
+/* readHeaderToken():
+ * 	Reads the next whitespace-separated token of a P6 header,
+ * 	skipping comments.
+ * args:
+ * 	@file: The stream to read from.
+ * 	@token: The location to store the token.
+ * return:
+ * 	true: if a token was read.
+ * 	false: if the stream ended first.
+ */
+bool readHeaderToken(FILE* file, std::string& token) {
+	int c = fgetc(file);
+
+	// Skip whitespace and comments
+	while(c != EOF && (isspace(c) || c == '#')) {
+		if(c == '#') {
+			while(c != EOF && c != '\n') {
+				c = fgetc(file);
+			}
+		}
+		c = fgetc(file);
+	}
+
+	token.clear();
+	while(c != EOF && !isspace(c)) {
+		token += (char)c;
+		c = fgetc(file);
+	}
+
+	return !token.empty();
+}
+
+
+/* validFrameSize():
+ * 	Tests whether a frame size read from a stream is usable.
+ * args:
+ * 	@rows: The number of rows.
+ * 	@cols: The number of columns.
+ * return:
+ * 	bool: true if both are positive and the frame is not too large.
+ */
+bool validFrameSize(long rows, long cols) {
+	return rows > 0 && cols > 0 && rows <= STREAM_MAX_PIXELS && cols <= STREAM_MAX_PIXELS
+		&& rows * cols <= STREAM_MAX_PIXELS;
+}
+
+
+/* readPPMFrame():
+ * 	Reads the next P6 image of a stream.
+ * args:
+ * 	@reader: The open stream.
+ * 	@frame: The location to store the frame.
+ * return:
+ * 	true: if a frame was read.
+ * 	false: if the stream has ended.
+ */
+bool readPPMFrame(FrameReader& reader, StreamFrame& frame) {
+	std::string magic, width, height, levels;
+
+	if(!readHeaderToken(reader.file, magic)) {
+		return false;
+	}
+	if(magic != "P6" || !readHeaderToken(reader.file, width)
+		|| !readHeaderToken(reader.file, height) || !readHeaderToken(reader.file, levels)) {
+		std::cerr << "Error: Stream frame is not PPM" << std::endl;
+		exit(1);
+	}
+	long maxValue = strtol(levels.c_str(), NULL, 10);
+	if(maxValue < 1 || maxValue > 255) {
+		std::cerr << "Error: Only 8-bit stream frames are supported" << std::endl;
+		exit(1);
+	}
+
+	long cols = strtol(width.c_str(), NULL, 10);
+	long rows = strtol(height.c_str(), NULL, 10);
+	if(!validFrameSize(rows, cols)) {
+		std::cerr << "Error: Stream frame size " << width << "x" << height << " is not supported" << std::endl;
+		exit(1);
+	}
+	frame.cols = (int)cols;
+	frame.rows = (int)rows;
+	frame.pixels.resize((size_t)frame.rows * frame.cols * 3);
+
+	if(fread(frame.pixels.data(), 1, frame.pixels.size(), reader.file) != frame.pixels.size()) {
+		std::cerr << "Error: Stream ended partway through a frame" << std::endl;
+		exit(1);
+	}
+
+	return true;
+}
+
+
+/* readY4MHeader():
+ * 	Reads the stream header of a Y4M stream. The leading "YUV4MPEG2"
+ * 	has already been read.
+ * args:
+ * 	@reader: The open stream.
+ * return:
+ * 	void
+ */
+void readY4MHeader(FrameReader& reader) {
+	std::string line;
+	int c;
+
+	while((c = fgetc(reader.file)) != EOF && c != '\n') {
+		line += (char)c;
+	}
+
+	long rows = 0, cols = 0;
+	reader.chroma = 420;
+
+	// Parameters are space separated, each led by a one letter tag
+	size_t start = 0;
+	while(start < line.size()) {
+		size_t end = line.find(' ', start);
+		if(end == std::string::npos) {
+			end = line.size();
+		}
+		std::string param = line.substr(start, end - start);
+
+		if(!param.empty() && param[0] == 'W') {
+			cols = strtol(param.c_str() + 1, NULL, 10);
+		}
+		else if(!param.empty() && param[0] == 'H') {
+			rows = strtol(param.c_str() + 1, NULL, 10);
+		}
+		else if(!param.empty() && param[0] == 'C') {
+			if(param.compare(0, 4, "C420") == 0) {
+				reader.chroma = 420;
+			}
+			else if(param == "C422") {
+				reader.chroma = 422;
+			}
+			else if(param == "C444") {
+				reader.chroma = 444;
+			}
+			else if(param == "Cmono") {
+				reader.chroma = 0;
+			}
+			else {
+				std::cerr << "Error: Unsupported Y4M colour space " << param << std::endl;
+				exit(1);
+			}
+		}
+		start = end + 1;
+	}
+
+	if(rows == 0 || cols == 0) {
+		std::cerr << "Error: Y4M stream has no frame size" << std::endl;
+		exit(1);
+	}
+	if(!validFrameSize(rows, cols)) {
+		std::cerr << "Error: Y4M frame size " << cols << "x" << rows << " is not supported" << std::endl;
+		exit(1);
+	}
+	reader.rows = (int)rows;
+	reader.cols = (int)cols;
+}
+
+
+/* readY4MFrame():
+ * 	Reads the next frame of a Y4M stream and converts it to RGB
+ * 	with the BT.601 studio-range equations.
+ * args:
+ * 	@reader: The open stream.
+ * 	@frame: The location to store the frame.
+ * return:
+ * 	true: if a frame was read.
+ * 	false: if the stream has ended.
+ */
+bool readY4MFrame(FrameReader& reader, StreamFrame& frame) {
+	// Variables
+	int rows = reader.rows, cols = reader.cols;
+	int chromaRows = reader.chroma == 420 ? (rows + 1) / 2 : rows;
+	int chromaCols = reader.chroma == 444 ? cols : (cols + 1) / 2;
+	size_t lumaSize = (size_t)rows * cols;
+	size_t chromaSize = reader.chroma == 0 ? 0 : (size_t)chromaRows * chromaCols;
+	int c;
+
+	// Frame header: "FRAME" with optional parameters up to newline
+	c = fgetc(reader.file);
+	if(c == EOF) {
+		return false;
+	}
+	std::string tag(1, (char)c);
+	while((c = fgetc(reader.file)) != EOF && c != '\n') {
+		tag += (char)c;
+	}
+	if(tag.compare(0, 5, "FRAME") != 0) {
+		std::cerr << "Error: Y4M frame header is missing" << std::endl;
+		exit(1);
+	}
+
+	reader.planes.resize(lumaSize + chromaSize * 2);
+	if(fread(reader.planes.data(), 1, reader.planes.size(), reader.file) != reader.planes.size()) {
+		std::cerr << "Error: Stream ended partway through a frame" << std::endl;
+		exit(1);
+	}
+
+	const unsigned char* yPlane = reader.planes.data();
+	const unsigned char* cbPlane = yPlane + lumaSize;
+	const unsigned char* crPlane = cbPlane + chromaSize;
+
+	frame.rows = rows;
+	frame.cols = cols;
+	frame.pixels.resize(lumaSize * 3);
+
+	for(int i = 0; i < rows; i++) {
+		int ci = reader.chroma == 420 ? i / 2 : i;
+		for(int j = 0; j < cols; j++) {
+			int cj = reader.chroma == 444 ? j : j / 2;
+			int y = yPlane[(size_t)i * cols + j] - 16;
+			int cb = reader.chroma == 0 ? 0 : cbPlane[(size_t)ci * chromaCols + cj] - 128;
+			int cr = reader.chroma == 0 ? 0 : crPlane[(size_t)ci * chromaCols + cj] - 128;
+			int rgb[3] = { (298 * y + 409 * cr + 128) >> 8,
+				(298 * y - 100 * cb - 208 * cr + 128) >> 8,
+				(298 * y + 516 * cb + 128) >> 8 };
+
+			unsigned char* pixel = &frame.pixels[((size_t)i * cols + j) * 3];
+			for(int k = 0; k < 3; k++) {
+				pixel[k] = rgb[k] < 0 ? 0 : (rgb[k] > 255 ? 255 : rgb[k]);
+			}
+		}
+	}
+
+	return true;
+}
+
+
+/* openFrameStream():
+ * 	Opens a stream and works out its format.
+ * args:
+ * 	@fname: Path to the stream, or "-" for standard input.
+ * 	@reader: The location to store the open stream.
+ * return:
+ * 	void
+ */
+void openFrameStream(char fname[], FrameReader& reader) {
+	char magic[10];
+
+	reader.file = strcmp(fname, "-") == 0 ? stdin : fopen(fname, "rb");
+	if(reader.file == NULL) {
+		std::cerr << "Error: Could not open stream " << fname << std::endl;
+		exit(1);
+	}
+
+	// Y4M streams start with a one-off header; PPM frames each have their own
+	int c = fgetc(reader.file);
+	if(c == 'Y') {
+		magic[0] = (char)c;
+		if(fread(magic + 1, 1, 8, reader.file) != 8 || strncmp(magic, "YUV4MPEG2", 9) != 0) {
+			std::cerr << "Error: Stream " << fname << " is neither PPM nor Y4M" << std::endl;
+			exit(1);
+		}
+		reader.format = STREAM_Y4M;
+		readY4MHeader(reader);
+	}
+	else {
+		if(c != EOF) {
+			ungetc(c, reader.file);
+		}
+		reader.format = STREAM_PPM;
+		reader.rows = 0;
+		reader.cols = 0;
+		reader.chroma = 444;
+	}
+}
+
+
+/* readFrame():
+ * 	Reads the next frame of a stream.
+ * args:
+ * 	@reader: The open stream.
+ * 	@frame: The location to store the frame.
+ * return:
+ * 	true: if a frame was read.
+ * 	false: if the stream has ended.
+ */
+bool readFrame(FrameReader& reader, StreamFrame& frame) {
+	if(reader.format == STREAM_Y4M) {
+		return readY4MFrame(reader, frame);
+	}
+	return readPPMFrame(reader, frame);
+}
+
+
+/* closeFrameStream():
+ * 	Closes a stream opened with openFrameStream().
+ * args:
+ * 	@reader: The open stream.
+ * return:
+ * 	void
+ */
+void closeFrameStream(FrameReader& reader) {
+	if(reader.file != NULL && reader.file != stdin) {
+		fclose(reader.file);
+	}
+	reader.file = NULL;
+}
+
+
+/* prepareTemporalState():
+ * 	Sets up the state for a new stream. Nothing is reused until
+ * 	every tile has been classified once.
+ * args:
+ * 	@tile: The width and height of a tile.
+ * 	@tolerance: The largest change in any channel that keeps a
+ * 		tile's mask (0 reuses only unchanged tiles).
+ * 	@state: The location to store the state.
+ * return:
+ * 	void
+ */
+void prepareTemporalState(int tile, int tolerance, TemporalState& state) {
+	state.rows = 0;
+	state.cols = 0;
+	state.tile = tile < 1 ? 1 : tile;
+	state.tolerance = tolerance < 0 ? 0 : tolerance;
+	state.primed = false;
+	state.reference.clear();
+	state.mask.clear();
+	state.tilesReused = 0;
+	state.tilesClassified = 0;
+}
+
+
+/* tileChanged():
+ * 	Tests whether any pixel of a tile moved beyond the tolerance
+ * 	since the tile was last classified.
+ * args:
+ * 	@frame: The new frame.
+ * 	@state: The state holding the reference pixels.
+ * 	@i0: First row of the tile.
+ * 	@i1: One past the last row of the tile.
+ * 	@j0: First column of the tile.
+ * 	@j1: One past the last column of the tile.
+ * return:
+ * 	true: if the tile must be classified again.
+ * 	false: if its previous mask still holds.
+ */
+bool tileChanged(const StreamFrame& frame, const TemporalState& state, int i0, int i1, int j0, int j1) {
+	size_t width = (size_t)(j1 - j0) * 3;
+
+	for(int i = i0; i < i1; i++) {
+		size_t offset = ((size_t)i * state.cols + j0) * 3;
+		const unsigned char* now = &frame.pixels[offset];
+		const unsigned char* then = &state.reference[offset];
+
+		if(state.tolerance == 0) {
+			if(memcmp(now, then, width) != 0) {
+				return true;
+			}
+			continue;
+		}
+		for(size_t k = 0; k < width; k++) {
+			int diff = (int)now[k] - (int)then[k];
+			if(diff > state.tolerance || -diff > state.tolerance) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+
+/* classifyTile():
+ * 	Classifies every pixel of a tile and remembers the pixels it
+ * 	was classified from.
+ * args:
+ * 	@frame: The frame to classify.
+ * 	@model: The model and threshold to classify with.
+ * 	@filter: The prefilter prepared for the model.
+ * 	@state: The state to store the mask and reference pixels in.
+ * 	@i0: First row of the tile.
+ * 	@i1: One past the last row of the tile.
+ * 	@j0: First column of the tile.
+ * 	@j1: One past the last column of the tile.
+ * return:
+ * 	void
+ */
+void classifyTile(const StreamFrame& frame, const SkinModel& model, const SkinPrefilter& filter,
+	TemporalState& state, int i0, int i1, int j0, int j1) {
+	std::vector<float> x0(j1 - j0), x1(j1 - j0);
+
+	for(int i = i0; i < i1; i++) {
+		size_t start = (size_t)i * state.cols + j0;
+		const unsigned char* span = &frame.pixels[start * 3];
+		unsigned char* mask = &state.mask[start];
+
+		featuresForPixels(model.isRGB, span, j1 - j0, x0.data(), x1.data());
+		for(int p = 0; p < j1 - j0; p++) {
+			bool skin = passesSkinPrefilter(span[p*3], span[p*3+1], span[p*3+2], filter)
+				&& scoreForFeatures(x0[p], x1[p], model) > model.t;
+			mask[p] = skin ? 255 : 0;
+		}
+
+		memcpy(&state.reference[start * 3], span, (size_t)(j1 - j0) * 3);
+	}
+}
+
+
+/* classifyFrameTemporal():
+ * 	Classifies skin pixels within a frame, reclassifying only the
+ * 	tiles that changed beyond the tolerance. The mask is left in
+ * 	state.mask. Tile rows are split across threads.
+ * args:
+ * 	@frame: The frame to classify.
+ * 	@model: The model and threshold to classify with.
+ * 	@filter: The prefilter prepared for the model.
+ * 	@state: The state left by earlier frames of the stream.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void classifyFrameTemporal(const StreamFrame& frame, const SkinModel& model,
+	const SkinPrefilter& filter, TemporalState& state, int threads) {
+	std::atomic<long> reused(0), classified(0);
+
+	// A new frame size starts the stream over
+	if(frame.rows != state.rows || frame.cols != state.cols) {
+		state.rows = frame.rows;
+		state.cols = frame.cols;
+		state.primed = false;
+		state.reference.assign(frame.pixels.size(), 0);
+		state.mask.assign((size_t)frame.rows * frame.cols, 0);
+	}
+
+	int tileRows = (state.rows + state.tile - 1) / state.tile;
+	int tileCols = (state.cols + state.tile - 1) / state.tile;
+	bool primed = state.primed;
+
+	parallelFor(tileRows, threads, [&](int begin, int end) {
+		long bandReused = 0, bandClassified = 0;
+
+		for(int ti = begin; ti < end; ti++) {
+			int i0 = ti * state.tile;
+			int i1 = i0 + state.tile < state.rows ? i0 + state.tile : state.rows;
+			for(int tj = 0; tj < tileCols; tj++) {
+				int j0 = tj * state.tile;
+				int j1 = j0 + state.tile < state.cols ? j0 + state.tile : state.cols;
+
+				if(primed && !tileChanged(frame, state, i0, i1, j0, j1)) {
+					bandReused++;
+					continue;
+				}
+				classifyTile(frame, model, filter, state, i0, i1, j0, j1);
+				bandClassified++;
+			}
+		}
+
+		reused += bandReused;
+		classified += bandClassified;
+	});
+
+	state.primed = true;
+	state.tilesReused += reused;
+	state.tilesClassified += classified;
+}
+
+
+/* writeMaskFrame():
+ * 	Appends a mask to a stream as a P5 image.
+ * args:
+ * 	@file: The stream to write to.
+ * 	@rows: Number of rows in the mask.
+ * 	@cols: Number of columns in the mask.
+ * 	@mask: One value per pixel, row by row.
+ * return:
+ * 	void
+ */
+void writeMaskFrame(FILE* file, int rows, int cols, const unsigned char* mask) {
+	char header[100];
+	int headerLen = formatImageHeader(header, rows, cols, 255, false);
+
+	if(fwrite(header, 1, headerLen, file) != (size_t)headerLen
+		|| fwrite(mask, 1, (size_t)rows * cols, file) != (size_t)rows * cols) {
+		std::cerr << "Error: Could not write mask frame" << std::endl;
+		exit(1);
+	}
+}
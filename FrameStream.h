@@ -0,0 +1,146 @@
+/* FrameStream.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for classifying a sequence of frames (e.g. from
+ * 	a camera) read from a file or pipe.
+ *
+ * 	A stream is either P6 images written back to back or a YUV4MPEG2
+ * 	(Y4M) stream with 4:2:0, 4:2:2, 4:4:4 or mono chroma. Frames are
+ * 	split into square tiles; a tile whose pixels are all within a
+ * 	tolerance of the pixels it was last classified from keeps its
+ * 	previous mask instead of being classified again.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef FRAMESTREAM_H_
+#define FRAMESTREAM_H_
+
+#include <stdio.h>
+#include <vector>
+
+#include "SkinModel.h"
+#include "SkinRegion.h"
+
+#define STREAM_PPM  0     // Back-to-back P6 images.
+#define STREAM_Y4M  1     // YUV4MPEG2 stream.
+
+/* StreamFrame:
+ * 	One frame of a stream as 8-bit interleaved RGB values.
+ */
+struct StreamFrame {
+	int rows;                            // rows: Number of pixel rows.
+	int cols;                            // cols: Number of pixel columns.
+	std::vector<unsigned char> pixels;   // pixels: RGB values, row by row.
+};
+
+/* FrameReader:
+ * 	An open stream and what is known about its format.
+ */
+struct FrameReader {
+	FILE* file;                          // file: The stream being read.
+	int format;                          // format: STREAM_PPM or STREAM_Y4M.
+	int rows;                            // rows: Frame rows (Y4M only).
+	int cols;                            // cols: Frame columns (Y4M only).
+	int chroma;                          // chroma: 420, 422, 444 or 0 for mono (Y4M only).
+	std::vector<unsigned char> planes;   // planes: Y, Cb and Cr of the last frame (Y4M only).
+};
+
+/* TemporalState:
+ * 	What the previous frames left behind for the next one to reuse.
+ */
+struct TemporalState {
+	int rows;                               // rows: Frame rows.
+	int cols;                               // cols: Frame columns.
+	int tile;                               // tile: Width and height of a tile.
+	int tolerance;                          // tolerance: Largest change in any channel that keeps a tile.
+	bool primed;                            // primed: Every tile has been classified once.
+	std::vector<unsigned char> reference;   // reference: Pixels each tile was last classified from.
+	std::vector<unsigned char> mask;        // mask: One value per pixel (255=skin, 0=not).
+	long tilesReused;                       // tilesReused: Tiles kept from earlier frames.
+	long tilesClassified;                   // tilesClassified: Tiles classified again.
+};
+
+
+/* openFrameStream():
+ * 	Opens a stream and works out its format.
+ * args:
+ * 	@fname: Path to the stream, or "-" for standard input.
+ * 	@reader: The location to store the open stream.
+ * return:
+ * 	void
+ */
+void openFrameStream(char fname[], FrameReader& reader);
+
+
+/* readFrame():
+ * 	Reads the next frame of a stream.
+ * args:
+ * 	@reader: The open stream.
+ * 	@frame: The location to store the frame.
+ * return:
+ * 	true: if a frame was read.
+ * 	false: if the stream has ended.
+ */
+bool readFrame(FrameReader& reader, StreamFrame& frame);
+
+
+/* closeFrameStream():
+ * 	Closes a stream opened with openFrameStream().
+ * args:
+ * 	@reader: The open stream.
+ * return:
+ * 	void
+ */
+void closeFrameStream(FrameReader& reader);
+
+
+/* prepareTemporalState():
+ * 	Sets up the state for a new stream. Nothing is reused until
+ * 	every tile has been classified once.
+ * args:
+ * 	@tile: The width and height of a tile.
+ * 	@tolerance: The largest change in any channel that keeps a
+ * 		tile's mask (0 reuses only unchanged tiles).
+ * 	@state: The location to store the state.
+ * return:
+ * 	void
+ */
+void prepareTemporalState(int tile, int tolerance, TemporalState& state);
+
+
+/* classifyFrameTemporal():
+ * 	Classifies skin pixels within a frame, reclassifying only the
+ * 	tiles that changed beyond the tolerance. The mask is left in
+ * 	state.mask. Tile rows are split across threads.
+ * args:
+ * 	@frame: The frame to classify.
+ * 	@model: The model and threshold to classify with.
+ * 	@filter: The prefilter prepared for the model.
+ * 	@state: The state left by earlier frames of the stream.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void classifyFrameTemporal(const StreamFrame& frame, const SkinModel& model,
+	const SkinPrefilter& filter, TemporalState& state, int threads = 0);
+
+
+/* writeMaskFrame():
+ * 	Appends a mask to a stream as a P5 image.
+ * args:
+ * 	@file: The stream to write to.
+ * 	@rows: Number of rows in the mask.
+ * 	@cols: Number of columns in the mask.
+ * 	@mask: One value per pixel, row by row.
+ * return:
+ * 	void
+ */
+void writeMaskFrame(FILE* file, int rows, int cols, const unsigned char* mask);
+
+#include "FrameStream.cpp"
+
+#endif
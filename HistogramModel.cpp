@@ -0,0 +1,382 @@
+/* HistogramModel.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for the colour histogram skin model.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <iostream>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "image.h"
+#include "HistogramModel.h"
+#include "ColourSpace.h"
+#include "MemoryStats.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+
+
+// Functions
+
+/* histogramCells():
+ * 	Gets the number of cells of a space at a bin count.
+ * args:
+ * 	@space: One of HIST_SPACE_*.
+ * 	@bins: Bins along each axis.
+ * return:
+ * 	long: The number of cells.
+ */
+long histogramCells(int space, int bins) {
+	return space == HIST_SPACE_RGB ? (long)bins * bins * bins : (long)bins * bins;
+}
+
+
+/* histogramModelBytes():
+ * 	Gets the memory held by the tables of a model.
+ * args:
+ * 	@model: The model.
+ * return:
+ * 	long: The size in bytes.
+ */
+long histogramModelBytes(const HistogramModel& model) {
+	return (model.skin.size() + model.other.size()) * sizeof(uint32_t)
+		+ model.logOdds.size() * sizeof(float) + model.cell.size() * sizeof(uint16_t);
+}
+
+
+/* binForFeature():
+ * 	Finds the bin of a feature value within a range.
+ * args:
+ * 	@x: The feature value.
+ * 	@lo: The low end of the range.
+ * 	@width: The width of the range.
+ * 	@bins: Bins across the range.
+ * return:
+ * 	int: The bin, clamped to the range.
+ */
+inline int binForFeature(float x, float lo, float width, int bins) {
+	int bin = (int)((x - lo) * bins / width);
+	return bin < 0 ? 0 : (bin >= bins ? bins - 1 : bin);
+}
+
+
+/* cellForPixel():
+ * 	Finds the histogram cell of a pixel value.
+ * args:
+ * 	@model: The model.
+ * 	@r, @g, @b: The pixel value.
+ * return:
+ * 	long: The cell.
+ */
+inline long cellForPixel(const HistogramModel& model, int r, int g, int b) {
+	if(model.space == HIST_SPACE_RGB) {
+		return ((long)model.axis[r] * model.bins + model.axis[g]) * model.bins + model.axis[b];
+	}
+	return model.cell[(r << 16) | (g << 8) | b];
+}
+
+
+/* initHistogramModel():
+ * 	Sets up an empty model. For the 2D spaces this also fills the
+ * 	table of every colour's cell (32 MiB), split across threads.
+ * args:
+ * 	@space: One of HIST_SPACE_*.
+ * 	@bins: Bins along each axis (cells must not exceed HIST_MAX_CELLS).
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void initHistogramModel(int space, int bins, HistogramModel& model) {
+	if(space < HIST_SPACE_RGB || space > HIST_SPACE_CBCR || bins < 1 || bins > 256
+		|| histogramCells(space, bins) > HIST_MAX_CELLS) {
+		std::cout << "Error: Invalid histogram space or bin count" << std::endl;
+		exit(1);
+	}
+
+	clearHistogramModel(model);
+	model.space = space;
+	model.bins = bins;
+	model.t = 0;
+	model.skin.assign(histogramCells(space, bins), 0);
+	model.other.assign(histogramCells(space, bins), 0);
+	model.logOdds.assign(histogramCells(space, bins), 0);
+	for(int v = 0; v < 256; v++) {
+		model.axis[v] = (unsigned char)(v * bins / 256);
+	}
+
+	// Bin every colour once so a 2D cell is a single lookup; rg lies
+	// in [0, 1], Cr and Cb in [-128, 128]
+	if(space != HIST_SPACE_RGB) {
+		bool isRGB = space == HIST_SPACE_RG;
+		float lo = isRGB ? 0 : -128, width = isRGB ? 1 : 256;
+
+		model.cell.resize(1 << 24);
+		parallelFor(256, 0, [&](int begin, int end) {
+			int rgb[256 * 3];
+			float x0[256], x1[256];
+			for(int r = begin; r < end; r++) {
+				for(int g = 0; g < 256; g++) {
+					for(int b = 0; b < 256; b++) {
+						rgb[b*3] = r;
+						rgb[b*3+1] = g;
+						rgb[b*3+2] = b;
+					}
+					featuresForPixels(isRGB, rgb, 256, x0, x1);
+
+					uint16_t* cells = &model.cell[(r << 16) | (g << 8)];
+					for(int b = 0; b < 256; b++) {
+						cells[b] = (uint16_t)(binForFeature(x0[b], lo, width, bins) * bins
+							+ binForFeature(x1[b], lo, width, bins));
+					}
+				}
+			}
+		});
+	}
+	trackAlloc(MEMORY_MODEL, histogramModelBytes(model));
+}
+
+
+/* clearHistogramModel():
+ * 	Releases the tables of a model.
+ * args:
+ * 	@model: The model.
+ * return:
+ * 	void
+ */
+void clearHistogramModel(HistogramModel& model) {
+	trackFree(MEMORY_MODEL, histogramModelBytes(model));
+	std::vector<uint32_t>().swap(model.skin);
+	std::vector<uint32_t>().swap(model.other);
+	std::vector<float>().swap(model.logOdds);
+	std::vector<uint16_t>().swap(model.cell);
+}
+
+
+/* addHistogramImages():
+ * 	Counts the pixels of a training image into the skin or other
+ * 	histogram by its reference. Rows are split across threads, each
+ * 	with its own histograms, which are summed at the end.
+ * args:
+ * 	@train: The training image.
+ * 	@ref: The reference image (white or red=skin).
+ * 	@model: The model to add to.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void addHistogramImages(ImageType& train, ImageType& ref, HistogramModel& model, int threads) {
+	int rows, cols, levels, refRows, refCols;
+	long cells = model.skin.size();
+
+	train.getImageInfo(rows, cols, levels);
+	ref.getImageInfo(refRows, refCols, levels);
+	if(rows != refRows || cols != refCols) {
+		std::cout << "Error: Training and reference images differ in size" << std::endl;
+		exit(1);
+	}
+
+	if(threads < 1) {
+		threads = defaultThreadCount();
+	}
+	if(threads > rows) {
+		threads = rows > 0 ? rows : 1;
+	}
+
+	// One pair of histograms per band; the first band adds in place
+	std::vector<std::vector<uint32_t> > bandSkin(threads - 1), bandOther(threads - 1);
+	trackAlloc(MEMORY_MODEL, (threads - 1) * cells * 2 * sizeof(uint32_t));
+	parallelFor(threads, threads, [&](int first, int last) {
+		for(int band = first; band < last; band++) {
+			uint32_t* skin = model.skin.data();
+			uint32_t* other = model.other.data();
+
+			if(band > 0) {
+				bandSkin[band - 1].assign(cells, 0);
+				bandOther[band - 1].assign(cells, 0);
+				skin = bandSkin[band - 1].data();
+				other = bandOther[band - 1].data();
+			}
+
+			int end = (int)((long)rows * (band + 1) / threads);
+			for(int i = (int)((long)rows * band / threads); i < end; i++) {
+				const int* trainRow = train.getRow(i);
+				const int* refRow = ref.getRow(i);
+				for(int j = 0; j < cols; j++) {
+					long cell = cellForPixel(model, trainRow[j*3], trainRow[j*3+1], trainRow[j*3+2]);
+					if(isSkinLabel(refRow[j*3], refRow[j*3+1], refRow[j*3+2])) {
+						skin[cell]++;
+					}
+					else {
+						other[cell]++;
+					}
+				}
+			}
+		}
+	});
+
+	for(size_t k = 0; k < bandSkin.size(); k++) {
+		for(long c = 0; c < cells; c++) {
+			model.skin[c] += bandSkin[k][c];
+			model.other[c] += bandOther[k][c];
+		}
+	}
+	trackFree(MEMORY_MODEL, (threads - 1) * cells * 2 * sizeof(uint32_t));
+}
+
+
+/* prepareHistogramModel():
+ * 	Fills in the log odds of every cell from the counts. Counts are
+ * 	smoothed by adding one to every cell of both histograms.
+ * args:
+ * 	@model: The model.
+ * return:
+ * 	void
+ */
+void prepareHistogramModel(HistogramModel& model) {
+	long cells = model.skin.size();
+	double skinCount = 0, otherCount = 0;
+
+	for(long c = 0; c < cells; c++) {
+		skinCount += model.skin[c];
+		otherCount += model.other[c];
+	}
+
+	// Likelihoods are (count + 1) / (total + cells); priors are the totals
+	// over both (kept above zero), so only the counts vary per cell
+	double offset = log((otherCount + cells) / (skinCount + cells))
+		+ log((skinCount + 1) / (otherCount + 1));
+	parallelFor((int)((cells + 4095) / 4096), 0, [&](int begin, int end) {
+		for(long c = (long)begin * 4096; c < (long)end * 4096 && c < cells; c++) {
+			model.logOdds[c] = log((model.skin[c] + 1.0) / (model.other[c] + 1.0)) + offset;
+		}
+	});
+}
+
+
+/* classifyForImageHistogram():
+ * 	Classifies skin pixels within an image. Rows are split across
+ * 	threads.
+ * args:
+ * 	@source: The image to classify.
+ * 	@dest: Location to output classified pixels (same size; white
+ * 		for skin, black otherwise).
+ * 	@model: The model.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void classifyForImageHistogram(ImageType& source, ImageType& dest, const HistogramModel& model,
+	int threads) {
+	int rows, cols, levels;
+
+	source.getImageInfo(rows, cols, levels);
+	parallelFor(rows, threads, [&](int begin, int end) {
+		RGB val;
+		for(int i = begin; i < end; i++) {
+			const int* row = source.getRow(i);
+			for(int j = 0; j < cols; j++) {
+				long cell = cellForPixel(model, row[j*3], row[j*3+1], row[j*3+2]);
+				int level = model.logOdds[cell] > model.t ? 255 : 0;
+				val.r = level;
+				val.g = level;
+				val.b = level;
+				dest.setPixelVal(i, j, val);
+			}
+		}
+	});
+}
+
+
+/* loadHistogramModel():
+ * 	Reads a model from a file written by saveHistogramModel().
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void loadHistogramModel(char fName[], HistogramModel& model) {
+	HistogramModelHeader header;
+	FILE* inFile = fopen(fName, "rb");
+
+	if(inFile == NULL) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	// Check the header before trusting the size it gives
+	if(fread(&header, sizeof(header), 1, inFile) != 1 || memcmp(header.magic, "SKNHIST1", 8) != 0
+		|| header.space < HIST_SPACE_RGB || header.space > HIST_SPACE_CBCR
+		|| header.bins < 1 || header.bins > 256
+		|| histogramCells(header.space, header.bins) > HIST_MAX_CELLS) {
+		std::cout << "Error: Invalid histogram model "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	initHistogramModel(header.space, header.bins, model);
+	model.t = header.t;
+	size_t cells = model.skin.size();
+	if(fread(model.skin.data(), sizeof(uint32_t), cells, inFile) != cells
+		|| fread(model.other.data(), sizeof(uint32_t), cells, inFile) != cells
+		|| fgetc(inFile) != EOF) {
+		std::cout << "Error: Invalid histogram model "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+	fclose(inFile);
+
+	prepareHistogramModel(model);
+}
+
+
+/* saveHistogramModel():
+ * 	Writes the counts and threshold of a model to a file.
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: The model to write.
+ * return:
+ * 	void
+ */
+void saveHistogramModel(char fName[], const HistogramModel& model) {
+	HistogramModelHeader header;
+	size_t cells = model.skin.size();
+	FILE* outFile = fopen(fName, "wb");
+
+	if(outFile == NULL) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "SKNHIST1", 8);
+	header.space = model.space;
+	header.bins = model.bins;
+	header.t = model.t;
+	if(fwrite(&header, sizeof(header), 1, outFile) != 1
+		|| fwrite(model.skin.data(), sizeof(uint32_t), cells, outFile) != cells
+		|| fwrite(model.other.data(), sizeof(uint32_t), cells, outFile) != cells
+		|| fclose(outFile) != 0) {
+		std::cout << "Error: Could not write "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+}
@@ -0,0 +1,171 @@
+/* HistogramModel.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for a non-parametric skin model built from
+ * 	colour histograms of skin and other pixels.
+ *
+ * 	The log posterior odds of skin are kept per histogram cell, so
+ * 	classifying a pixel is a lookup of its cell and a comparison
+ * 	with the threshold. In the 3D RGB space the cell comes straight
+ * 	from the pixel values; the 2D spaces keep the cell of every
+ * 	8-bit colour in a table filled when the model is set up.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef HISTOGRAMMODEL_H_
+#define HISTOGRAMMODEL_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "image.h"
+
+#define HIST_SPACE_RGB 0     // 3D histogram of r, g, b.
+#define HIST_SPACE_RG 1      // 2D histogram of the rg chromaticities.
+#define HIST_SPACE_CBCR 2    // 2D histogram of Cr and Cb.
+
+#define HIST_MAX_CELLS (1 << 24)
+
+/* HistogramModelHeader:
+ * 	The fixed-size start of a histogram model file. The skin counts
+ * 	and then the other counts follow, one uint32_t per cell.
+ */
+struct HistogramModelHeader {
+	char magic[8];      // magic: "SKNHIST1".
+	int32_t space;      // space: One of HIST_SPACE_*.
+	int32_t bins;       // bins: Bins along each axis.
+	float t;            // t: Threshold on the log odds.
+	int32_t reserved;   // reserved: Zero.
+};
+
+/* HistogramModel:
+ * 	Colour histograms of skin and other pixels and the log odds of
+ * 	skin in each cell.
+ */
+struct HistogramModel {
+	int space;                     // space: One of HIST_SPACE_*.
+	int bins;                      // bins: Bins along each axis.
+	float t;                       // t: Skin if a cell's log odds are greater.
+	std::vector<uint32_t> skin;    // skin: Skin pixels in each cell.
+	std::vector<uint32_t> other;   // other: Other pixels in each cell.
+	std::vector<float> logOdds;    // logOdds: log P(skin|cell) - log P(other|cell).
+	unsigned char axis[256];       // axis: Bin of each 8-bit value (3D space).
+	std::vector<uint16_t> cell;    // cell: Cell of each colour, r<<16|g<<8|b (2D spaces).
+};
+
+
+/* histogramCells():
+ * 	Gets the number of cells of a space at a bin count.
+ * args:
+ * 	@space: One of HIST_SPACE_*.
+ * 	@bins: Bins along each axis.
+ * return:
+ * 	long: The number of cells.
+ */
+long histogramCells(int space, int bins);
+
+
+/* initHistogramModel():
+ * 	Sets up an empty model. For the 2D spaces this also fills the
+ * 	table of every colour's cell (32 MiB), split across threads.
+ * args:
+ * 	@space: One of HIST_SPACE_*.
+ * 	@bins: Bins along each axis (cells must not exceed HIST_MAX_CELLS).
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void initHistogramModel(int space, int bins, HistogramModel& model);
+
+
+/* clearHistogramModel():
+ * 	Releases the tables of a model.
+ * args:
+ * 	@model: The model.
+ * return:
+ * 	void
+ */
+void clearHistogramModel(HistogramModel& model);
+
+
+/* addHistogramImages():
+ * 	Counts the pixels of a training image into the skin or other
+ * 	histogram by its reference. Rows are split across threads, each
+ * 	with its own histograms, which are summed at the end.
+ * args:
+ * 	@train: The training image.
+ * 	@ref: The reference image (white or red=skin).
+ * 	@model: The model to add to.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void addHistogramImages(ImageType& train, ImageType& ref, HistogramModel& model, int threads = 0);
+
+
+/* prepareHistogramModel():
+ * 	Fills in the log odds of every cell from the counts. Counts are
+ * 	smoothed by adding one to every cell of both histograms.
+ * args:
+ * 	@model: The model.
+ * return:
+ * 	void
+ */
+void prepareHistogramModel(HistogramModel& model);
+
+
+/* cellForPixel():
+ * 	Finds the histogram cell of a pixel value.
+ * args:
+ * 	@model: The model.
+ * 	@r, @g, @b: The pixel value.
+ * return:
+ * 	long: The cell.
+ */
+inline long cellForPixel(const HistogramModel& model, int r, int g, int b);
+
+
+/* classifyForImageHistogram():
+ * 	Classifies skin pixels within an image. Rows are split across
+ * 	threads.
+ * args:
+ * 	@source: The image to classify.
+ * 	@dest: Location to output classified pixels (same size; white
+ * 		for skin, black otherwise).
+ * 	@model: The model.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void classifyForImageHistogram(ImageType& source, ImageType& dest, const HistogramModel& model,
+	int threads = 0);
+
+
+/* loadHistogramModel():
+ * 	Reads a model from a file written by saveHistogramModel().
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void loadHistogramModel(char fName[], HistogramModel& model);
+
+
+/* saveHistogramModel():
+ * 	Writes the counts and threshold of a model to a file.
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: The model to write.
+ * return:
+ * 	void
+ */
+void saveHistogramModel(char fName[], const HistogramModel& model);
+
+#include "HistogramModel.cpp"
+
+#endif
@@ -0,0 +1,271 @@
+/* ImageCache.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for the cache of decoded images.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <iostream>
+#include <list>
+#include <mutex>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unordered_map>
+
+#include "image.h"
+#include "ImageCache.h"
+
+
+// Variables
+
+/* CachedImage:
+ * 	One decoded image and the file it was read from.
+ */
+struct CachedImage {
+	std::string path;      // path: The path of the file.
+	long long size;        // size: The file's size when read.
+	long long mtime;       // mtime: The file's modification time (ns) when read.
+	size_t bytes;          // bytes: Memory held by the image.
+	ImageType* image;      // image: The decoded image.
+};
+
+std::mutex cacheLock;
+std::list<CachedImage> cacheOrder;    // Most recently used first.
+std::unordered_map<std::string, std::list<CachedImage>::iterator> cacheIndex;
+ImageCacheStats cacheStats = { 0, 0, 0, 0, 0, 0 };
+bool cacheLimitSet = false;
+
+
+// Functions
+
+/* imageBytes():
+ * 	Gets the memory held by an image's pixels.
+ * args:
+ * 	@image: The image.
+ * return:
+ * 	size_t: The size in bytes.
+ */
+size_t imageBytes(ImageType& image) {
+	int rows, cols, levels;
+	image.getImageInfo(rows, cols, levels);
+	return (size_t)rows * (sizeof(int*) + 3 * (size_t)cols * sizeof(int));
+}
+
+
+/* fileVersion():
+ * 	Gets the size and modification time of a file.
+ * args:
+ * 	@fName: The path to the file.
+ * 	@size: Location to store the size.
+ * 	@mtime: Location to store the modification time (ns).
+ * return:
+ * 	bool: true if the file could be examined.
+ */
+bool fileVersion(const char* fName, long long& size, long long& mtime) {
+	struct stat info;
+
+	if(stat(fName, &info) != 0) {
+		return false;
+	}
+	size = info.st_size;
+	mtime = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+	return true;
+}
+
+
+/* loadCacheLimit():
+ * 	Sets the limit from the environment on first use. The caller
+ * 	holds cacheLock.
+ * return:
+ * 	void
+ */
+void loadCacheLimit() {
+	if(cacheLimitSet) {
+		return;
+	}
+
+	const char* mib = getenv("SKIN_IMAGE_CACHE");
+	cacheStats.limit = (size_t)(mib != NULL ? atol(mib) : IMAGE_CACHE_DEFAULT_MIB) << 20;
+	cacheLimitSet = true;
+}
+
+
+/* evictImages():
+ * 	Drops the least recently used images until the cache holds no
+ * 	more than a size. The caller holds cacheLock.
+ * args:
+ * 	@bytes: The most memory to keep.
+ * return:
+ * 	void
+ */
+void evictImages(size_t bytes) {
+	while(cacheStats.bytes > bytes && !cacheOrder.empty()) {
+		CachedImage& oldest = cacheOrder.back();
+		cacheStats.bytes -= oldest.bytes;
+		cacheStats.images--;
+		cacheStats.evictions++;
+		delete oldest.image;
+		cacheIndex.erase(oldest.path);
+		cacheOrder.pop_back();
+	}
+}
+
+
+/* setImageCacheLimit():
+ * 	Sets the most memory the cache may hold, dropping images until
+ * 	it fits. A limit of 0 turns the cache off.
+ * args:
+ * 	@bytes: The limit.
+ * return:
+ * 	void
+ */
+void setImageCacheLimit(size_t bytes) {
+	std::lock_guard<std::mutex> guard(cacheLock);
+
+	cacheStats.limit = bytes;
+	cacheLimitSet = true;
+	evictImages(bytes);
+}
+
+
+/* cachedImage():
+ * 	Copies a file's decoded image out of the cache, if the file is
+ * 	unchanged since it was cached.
+ * args:
+ * 	@fName: The path to the image.
+ * 	@image: Location to store the image.
+ * return:
+ * 	bool: true if found; false (and image untouched) otherwise.
+ */
+bool cachedImage(char fName[], ImageType& image) {
+	long long size, mtime;
+	std::lock_guard<std::mutex> guard(cacheLock);
+
+	loadCacheLimit();
+	if(cacheStats.limit == 0) {
+		return false;
+	}
+
+	auto found = cacheIndex.find(fName);
+	if(found == cacheIndex.end() || !fileVersion(fName, size, mtime)
+		|| found->second->size != size || found->second->mtime != mtime) {
+		cacheStats.misses++;
+		return false;
+	}
+
+	// Copy under the lock so the entry cannot be dropped meanwhile
+	cacheOrder.splice(cacheOrder.begin(), cacheOrder, found->second);
+	image = *found->second->image;
+	cacheStats.hits++;
+	return true;
+}
+
+
+/* cacheImage():
+ * 	Stores a copy of a file's decoded image.
+ * args:
+ * 	@fName: The path the image was read from.
+ * 	@image: The decoded image.
+ * return:
+ * 	void
+ */
+void cacheImage(char fName[], ImageType& image) {
+	CachedImage entry;
+	size_t limit;
+
+	{
+		std::lock_guard<std::mutex> guard(cacheLock);
+		loadCacheLimit();
+		limit = cacheStats.limit;
+	}
+	entry.bytes = imageBytes(image);
+	if(entry.bytes > limit || !fileVersion(fName, entry.size, entry.mtime)) {
+		return;
+	}
+
+	// Copy before taking the lock so other readers are not held up
+	entry.path = fName;
+	entry.image = new ImageType();
+	*entry.image = image;
+
+	std::lock_guard<std::mutex> guard(cacheLock);
+	if(entry.bytes > cacheStats.limit) {
+		delete entry.image;
+		return;
+	}
+
+	// Replace an older copy of the same path
+	auto found = cacheIndex.find(fName);
+	if(found != cacheIndex.end()) {
+		cacheStats.bytes -= found->second->bytes;
+		cacheStats.images--;
+		delete found->second->image;
+		cacheOrder.erase(found->second);
+		cacheIndex.erase(found);
+	}
+
+	evictImages(cacheStats.limit - entry.bytes);
+	cacheOrder.push_front(entry);
+	cacheIndex[entry.path] = cacheOrder.begin();
+	cacheStats.bytes += entry.bytes;
+	cacheStats.images++;
+}
+
+
+/* clearImageCache():
+ * 	Drops every image. The counts are kept.
+ * return:
+ * 	void
+ */
+void clearImageCache() {
+	std::lock_guard<std::mutex> guard(cacheLock);
+	long evictions = cacheStats.evictions;
+
+	evictImages(0);
+	cacheStats.evictions = evictions;
+}
+
+
+/* getImageCacheStats():
+ * 	Gets the counts of the cache's use.
+ * args:
+ * 	@stats: Location to store the counts.
+ * return:
+ * 	void
+ */
+void getImageCacheStats(ImageCacheStats& stats) {
+	std::lock_guard<std::mutex> guard(cacheLock);
+	loadCacheLimit();
+	stats = cacheStats;
+}
+
+
+/* reportImageCacheStats():
+ * 	Prints the counts of the cache's use, if it was used.
+ * args:
+ * 	@out: The stream to print to.
+ * return:
+ * 	void
+ */
+void reportImageCacheStats(std::ostream& out) {
+	ImageCacheStats stats;
+
+	getImageCacheStats(stats);
+	if(stats.hits + stats.misses == 0) {
+		return;
+	}
+
+	out << std::endl << "Image Cache" << std::endl;
+	out << "==============================" << std::endl;
+	out << "Hits: " << stats.hits << " Misses: " << stats.misses
+		<< " Evictions: " << stats.evictions << std::endl;
+	out << "Held: " << stats.images << " images, " << stats.bytes / 1024
+		<< " KiB of " << stats.limit / 1024 << " KiB" << std::endl;
+}
@@ -0,0 +1,106 @@
+/* ImageCache.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for a process-wide cache of decoded images,
+ * 	so stages that read the same file do not decode it again.
+ *
+ * 	Entries are keyed by path, file size, and modification time, so
+ * 	a rewritten file is decoded afresh. The least recently used
+ * 	images are dropped once the cache passes its memory limit. The
+ * 	limit is 256 MiB, or SKIN_IMAGE_CACHE MiB from the environment
+ * 	(0 turns the cache off). The batch pipeline reads each file once,
+ * 	so it bypasses the cache and its images stay within its budget.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef IMAGECACHE_H_
+#define IMAGECACHE_H_
+
+#include <iostream>
+#include <stddef.h>
+
+#include "image.h"
+
+#define IMAGE_CACHE_DEFAULT_MIB 256
+
+/* ImageCacheStats:
+ * 	Counts of the cache's use so far.
+ */
+struct ImageCacheStats {
+	long hits;        // hits: Reads answered from the cache.
+	long misses;      // misses: Reads that had to decode the file.
+	long evictions;   // evictions: Images dropped to stay under the limit.
+	long images;      // images: Images held now.
+	size_t bytes;     // bytes: Memory held now.
+	size_t limit;     // limit: Most memory the cache may hold.
+};
+
+
+/* setImageCacheLimit():
+ * 	Sets the most memory the cache may hold, dropping images until
+ * 	it fits. A limit of 0 turns the cache off.
+ * args:
+ * 	@bytes: The limit.
+ * return:
+ * 	void
+ */
+void setImageCacheLimit(size_t bytes);
+
+
+/* cachedImage():
+ * 	Copies a file's decoded image out of the cache, if the file is
+ * 	unchanged since it was cached.
+ * args:
+ * 	@fName: The path to the image.
+ * 	@image: Location to store the image.
+ * return:
+ * 	bool: true if found; false (and image untouched) otherwise.
+ */
+bool cachedImage(char fName[], ImageType& image);
+
+
+/* cacheImage():
+ * 	Stores a copy of a file's decoded image.
+ * args:
+ * 	@fName: The path the image was read from.
+ * 	@image: The decoded image.
+ * return:
+ * 	void
+ */
+void cacheImage(char fName[], ImageType& image);
+
+
+/* clearImageCache():
+ * 	Drops every image. The counts are kept.
+ * return:
+ * 	void
+ */
+void clearImageCache();
+
+
+/* getImageCacheStats():
+ * 	Gets the counts of the cache's use.
+ * args:
+ * 	@stats: Location to store the counts.
+ * return:
+ * 	void
+ */
+void getImageCacheStats(ImageCacheStats& stats);
+
+
+/* reportImageCacheStats():
+ * 	Prints the counts of the cache's use, if it was used.
+ * args:
+ * 	@out: The stream to print to.
+ * return:
+ * 	void
+ */
+void reportImageCacheStats(std::ostream& out);
+
+#include "ImageCache.cpp"
+
+#endif
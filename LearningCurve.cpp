@@ -0,0 +1,207 @@
+/* LearningCurve.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for sweeping the sample size of the Gaussian point
+ * 	classifier.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <algorithm>
+#include <iostream>
+#include <math.h>
+#include <random>
+#include <stdlib.h>
+#include <vector>
+
+#include "LearningCurve.h"
+#include "CrossValidate.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+#include "PointFile.h"
+#include "SkinModel.h"
+
+
+// Functions
+
+/* errorRateForModels():
+ * 	Classifies every point with both class Gaussians.
+ * args:
+ * 	@points: The points (labels 1 and 2).
+ * 	@model: The Gaussian of each class.
+ * return:
+ * 	float: The portion of points classified wrongly.
+ */
+float errorRateForModels(const PointColumns& points, const SkinModel model[2]) {
+	long misclass = 0;
+
+	for(size_t k = 0; k < points.x.size(); k++) {
+		float g1 = scoreForFeatures(points.x[k], points.y[k], model[0]) + model[0].t;
+		float g2 = scoreForFeatures(points.x[k], points.y[k], model[1]) + model[1].t;
+		int c = points.id[k] == 2 ? 1 : 0;
+		misclass += (g1 < g2 ? 1 : 0) != c;
+	}
+
+	return (float)misclass / points.x.size();
+}
+
+
+/* learningCurve():
+ * 	Estimates both class Gaussians from random samples of several
+ * 	sizes and tests each estimate on every point. Samples are drawn
+ * 	without replacement, and the same portion is taken from each
+ * 	class (as in the 0.01%-10% experiments). Repetitions are split
+ * 	across threads; results do not depend on the thread count.
+ * args:
+ * 	@points: The points (labels 1 and 2).
+ * 	@fractions: The portions of each class to sample (0 to 1].
+ * 	@repetitions: The number of random samples of each size.
+ * 	@seed: The seed of the first repetition.
+ * 	@curve: Location to store the results, one per fraction.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void learningCurve(const PointColumns& points, const std::vector<double>& fractions,
+	int repetitions, unsigned seed, std::vector<CurvePoint>& curve, int threads) {
+	std::vector<size_t> members[2];
+	FeatureStats all[2];
+	float refMu[2][2], refCov[2][2][2];
+
+	if(repetitions < 1) {
+		std::cout << "Error: Need at least one repetition" << std::endl;
+		exit(1);
+	}
+
+	// Split points by class and find the full-data estimates
+	clearFeatureStats(all[0]);
+	clearFeatureStats(all[1]);
+	for(size_t k = 0; k < points.x.size(); k++) {
+		int c = points.id[k] == 2 ? 1 : 0;
+		members[c].push_back(k);
+		addFeatureSample(all[c], points.x[k], points.y[k]);
+	}
+	for(int c = 0; c < 2; c++) {
+		if(members[c].size() < 2) {
+			std::cout << "Error: Too few points in a class to build a model" << std::endl;
+			exit(1);
+		}
+		meanCovForStats(all[c], refMu[c], refCov[c]);
+	}
+
+	// Sample sizes, visited smallest first
+	curve.resize(fractions.size());
+	std::vector<size_t> bySize(fractions.size());
+	long largest[2] = { 0, 0 };
+	for(size_t s = 0; s < fractions.size(); s++) {
+		CurvePoint& point = curve[s];
+		point.fraction = fractions[s];
+		for(int c = 0; c < 2; c++) {
+			point.count[c] = (long)(members[c].size() * fractions[s]);
+			if(fractions[s] <= 0 || fractions[s] > 1 || point.count[c] < 2) {
+				std::cout << "Error: Portion " << fractions[s]
+					<< " samples fewer than 2 points of a class" << std::endl;
+				exit(1);
+			}
+			largest[c] = std::max(largest[c], point.count[c]);
+			point.meanError[c].assign(repetitions, 0);
+			point.covError[c].assign(repetitions, 0);
+		}
+		point.errorRate.assign(repetitions, 0);
+		bySize[s] = s;
+	}
+	std::sort(bySize.begin(), bySize.end(), [&](size_t a, size_t b) {
+		return fractions[a] < fractions[b];
+	});
+
+	parallelFor(repetitions, threads, [&](int begin, int end) {
+		std::vector<size_t> order[2];
+
+		for(int r = begin; r < end; r++) {
+			std::mt19937 rng(seed + r);
+			FeatureStats running[2];
+			long used[2] = { 0, 0 };
+
+			// Shuffle only as far as the largest sample, always starting
+			// from the same order so each repetition depends only on r
+			for(int c = 0; c < 2; c++) {
+				order[c].assign(members[c].begin(), members[c].end());
+				size_t n = order[c].size();
+				for(long k = 0; k < largest[c]; k++) {
+					std::uniform_int_distribution<size_t> pick(k, n - 1);
+					std::swap(order[c][k], order[c][pick(rng)]);
+				}
+				clearFeatureStats(running[c]);
+			}
+
+			// Extend the running statistics to each size in turn
+			for(size_t s = 0; s < bySize.size(); s++) {
+				CurvePoint& point = curve[bySize[s]];
+				SkinModel model[2];
+
+				for(int c = 0; c < 2; c++) {
+					for(; used[c] < point.count[c]; used[c]++) {
+						size_t p = order[c][used[c]];
+						addFeatureSample(running[c], points.x[p], points.y[p]);
+					}
+				}
+				for(int c = 0; c < 2; c++) {
+					double dMu = 0, dCov = 0;
+
+					classModelForStats(running[c], running[c].n / (running[0].n + running[1].n), model[c]);
+					for(int i = 0; i < 2; i++) {
+						dMu += (model[c].mu[i] - refMu[c][i]) * (model[c].mu[i] - refMu[c][i]);
+						for(int j = 0; j < 2; j++) {
+							double d = model[c].cov[i][j] - refCov[c][i][j];
+							dCov += d * d;
+						}
+					}
+					point.meanError[c][r] = sqrt(dMu);
+					point.covError[c][r] = sqrt(dCov);
+				}
+				point.errorRate[r] = errorRateForModels(points, model);
+			}
+		}
+	});
+}
+
+
+/* summarizeCurveValues():
+ * 	Finds the mean, standard deviation, and central 95% band of
+ * 	the values of a sample size.
+ * args:
+ * 	@values: The values, one per repetition.
+ * 	@mean: Location to store the mean.
+ * 	@sd: Location to store the standard deviation.
+ * 	@lo: Location to store the 2.5th percentile.
+ * 	@hi: Location to store the 97.5th percentile.
+ * return:
+ * 	void
+ */
+void summarizeCurveValues(const std::vector<float>& values, float& mean, float& sd,
+	float& lo, float& hi) {
+	std::vector<float> sorted(values);
+	size_t n = sorted.size();
+	double sum = 0, sumSq = 0;
+
+	if(n == 0) {
+		mean = sd = lo = hi = 0;
+		return;
+	}
+
+	for(size_t k = 0; k < n; k++) {
+		sum += sorted[k];
+		sumSq += (double)sorted[k] * sorted[k];
+	}
+	mean = sum / n;
+	sd = n > 1 ? sqrt(std::max(0.0, (sumSq - sum * sum / n) / (n - 1))) : 0;
+
+	std::sort(sorted.begin(), sorted.end());
+	lo = sorted[(size_t)(0.025 * (n - 1) + 0.5)];
+	hi = sorted[(size_t)(0.975 * (n - 1) + 0.5)];
+}
@@ -0,0 +1,74 @@
+/* LearningCurve.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for measuring how the Gaussian classifier of
+ * 	the point experiments improves with the number of samples.
+ *
+ * 	Each repetition shuffles every class once and keeps running
+ * 	statistics along the shuffled order, so all sample sizes of a
+ * 	repetition come from one pass; no subset files are written.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef LEARNINGCURVE_H_
+#define LEARNINGCURVE_H_
+
+#include <vector>
+
+#include "PointFile.h"
+
+/* CurvePoint:
+ * 	Results at one sample size, one entry per repetition. Arrays of
+ * 	two are indexed by class (0=class 1, 1=class 2).
+ */
+struct CurvePoint {
+	double fraction;                  // fraction: Portion of each class sampled.
+	long count[2];                    // count: Points sampled from each class.
+	std::vector<float> meanError[2];  // meanError: Distance from the full-data mean.
+	std::vector<float> covError[2];   // covError: Frobenius distance from the full-data covariance.
+	std::vector<float> errorRate;     // errorRate: Misclassification rate over every point.
+};
+
+
+/* learningCurve():
+ * 	Estimates both class Gaussians from random samples of several
+ * 	sizes and tests each estimate on every point. Samples are drawn
+ * 	without replacement, and the same portion is taken from each
+ * 	class (as in the 0.01%-10% experiments). Repetitions are split
+ * 	across threads; results do not depend on the thread count.
+ * args:
+ * 	@points: The points (labels 1 and 2).
+ * 	@fractions: The portions of each class to sample (0 to 1].
+ * 	@repetitions: The number of random samples of each size.
+ * 	@seed: The seed of the first repetition.
+ * 	@curve: Location to store the results, one per fraction.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void learningCurve(const PointColumns& points, const std::vector<double>& fractions,
+	int repetitions, unsigned seed, std::vector<CurvePoint>& curve, int threads = 0);
+
+
+/* summarizeCurveValues():
+ * 	Finds the mean, standard deviation, and central 95% band of
+ * 	the values of a sample size.
+ * args:
+ * 	@values: The values, one per repetition.
+ * 	@mean: Location to store the mean.
+ * 	@sd: Location to store the standard deviation.
+ * 	@lo: Location to store the 2.5th percentile.
+ * 	@hi: Location to store the 97.5th percentile.
+ * return:
+ * 	void
+ */
+void summarizeCurveValues(const std::vector<float>& values, float& mean, float& sd,
+	float& lo, float& hi);
+
+#include "LearningCurve.cpp"
+
+#endif
@@ -0,0 +1,138 @@
+/* MemoryStats.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for counting the memory held by each part of the
+ * 	program.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+
+#include "MemoryStats.h"
+
+
+// Variables
+
+std::atomic<bool> memoryEnabled(false);
+std::atomic<long> memoryLive[MEMORY_KINDS];
+std::atomic<long> memoryPeak[MEMORY_KINDS];
+std::atomic<long> memoryAllocs[MEMORY_KINDS];
+
+
+// Functions
+
+/* enableMemoryAccounting():
+ * 	Turns accounting on or off. Memory allocated while it is off
+ * 	is never counted, so it should be enabled before other work.
+ * args:
+ * 	@on: true to count allocations from now on.
+ * return:
+ * 	void
+ */
+void enableMemoryAccounting(bool on) {
+	memoryEnabled.store(on, std::memory_order_relaxed);
+}
+
+
+/* memoryAccountingEnabled():
+ * 	Tests whether accounting is on.
+ * return:
+ * 	bool: true if allocations are counted.
+ */
+inline bool memoryAccountingEnabled() {
+	return memoryEnabled.load(std::memory_order_relaxed);
+}
+
+
+/* trackAlloc():
+ * 	Counts an allocation.
+ * args:
+ * 	@kind: The part of the program that allocated (MEMORY_*).
+ * 	@bytes: The size of the allocation.
+ * return:
+ * 	void
+ */
+inline void trackAlloc(int kind, size_t bytes) {
+	if(!memoryAccountingEnabled()) {
+		return;
+	}
+
+	long live = memoryLive[kind].fetch_add((long)bytes, std::memory_order_relaxed) + (long)bytes;
+	memoryAllocs[kind].fetch_add(1, std::memory_order_relaxed);
+
+	// Raise the peak unless another thread already raised it further
+	long peak = memoryPeak[kind].load(std::memory_order_relaxed);
+	while(live > peak && !memoryPeak[kind].compare_exchange_weak(peak, live,
+		std::memory_order_relaxed)) {
+	}
+}
+
+
+/* trackFree():
+ * 	Counts the release of an earlier counted allocation.
+ * args:
+ * 	@kind: The part of the program that allocated (MEMORY_*).
+ * 	@bytes: The size of the allocation.
+ * return:
+ * 	void
+ */
+inline void trackFree(int kind, size_t bytes) {
+	if(!memoryAccountingEnabled()) {
+		return;
+	}
+
+	memoryLive[kind].fetch_sub((long)bytes, std::memory_order_relaxed);
+}
+
+
+/* getMemoryUsage():
+ * 	Gets the memory counted for one part of the program.
+ * args:
+ * 	@kind: The part of the program (MEMORY_*).
+ * 	@usage: Location to store the counts.
+ * return:
+ * 	void
+ */
+void getMemoryUsage(int kind, MemoryUsage& usage) {
+	usage.live = memoryLive[kind].load(std::memory_order_relaxed);
+	usage.peak = memoryPeak[kind].load(std::memory_order_relaxed);
+	usage.allocs = memoryAllocs[kind].load(std::memory_order_relaxed);
+}
+
+
+/* reportMemoryUsage():
+ * 	Prints the counts for every part of the program, if accounting
+ * 	is on.
+ * args:
+ * 	@out: The stream to print to.
+ * return:
+ * 	void
+ */
+void reportMemoryUsage(std::ostream& out) {
+	const char* names[MEMORY_KINDS] = { "Image storage", "I/O buffers", "Datasets", "Models" };
+
+	if(!memoryAccountingEnabled()) {
+		return;
+	}
+
+	out << std::endl << "Memory Summary (KiB)" << std::endl;
+	out << "==============================" << std::endl;
+	out << std::left << std::setw(16) << "" << std::right << std::setw(12) << "live"
+		<< std::setw(12) << "peak" << std::setw(10) << "allocs" << std::endl;
+	for(int k = 0; k < MEMORY_KINDS; k++) {
+		MemoryUsage usage;
+		getMemoryUsage(k, usage);
+		out << std::left << std::setw(16) << names[k] << std::right
+			<< std::setw(12) << usage.live / 1024
+			<< std::setw(12) << usage.peak / 1024
+			<< std::setw(10) << usage.allocs << std::endl;
+	}
+}
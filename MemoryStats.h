@@ -0,0 +1,103 @@
+/* MemoryStats.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for counting the memory held by each part of
+ * 	the program, so runs can report how much they needed.
+ *
+ * 	Accounting is off unless enabled (e.g. SKIN_MEMORY=1 in the
+ * 	environment); when off, tracking is a single flag test.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef MEMORYSTATS_H_
+#define MEMORYSTATS_H_
+
+#include <atomic>
+#include <iostream>
+#include <stddef.h>
+
+#define MEMORY_IMAGE    0     // Pixel storage of images and score maps.
+#define MEMORY_IO       1     // Buffers for reading and writing files.
+#define MEMORY_DATASET  2     // Samples read from data files.
+#define MEMORY_MODEL    3     // Tables and statistics for models.
+#define MEMORY_KINDS    4
+
+/* MemoryUsage:
+ * 	The memory counted for one part of the program.
+ */
+struct MemoryUsage {
+	long live;      // live: Bytes held now.
+	long peak;      // peak: Most bytes held at once.
+	long allocs;    // allocs: Number of allocations.
+};
+
+
+/* enableMemoryAccounting():
+ * 	Turns accounting on or off. Memory allocated while it is off
+ * 	is never counted, so it should be enabled before other work.
+ * args:
+ * 	@on: true to count allocations from now on.
+ * return:
+ * 	void
+ */
+void enableMemoryAccounting(bool on);
+
+
+/* memoryAccountingEnabled():
+ * 	Tests whether accounting is on.
+ * return:
+ * 	bool: true if allocations are counted.
+ */
+inline bool memoryAccountingEnabled();
+
+
+/* trackAlloc():
+ * 	Counts an allocation.
+ * args:
+ * 	@kind: The part of the program that allocated (MEMORY_*).
+ * 	@bytes: The size of the allocation.
+ * return:
+ * 	void
+ */
+inline void trackAlloc(int kind, size_t bytes);
+
+
+/* trackFree():
+ * 	Counts the release of an earlier counted allocation.
+ * args:
+ * 	@kind: The part of the program that allocated (MEMORY_*).
+ * 	@bytes: The size of the allocation.
+ * return:
+ * 	void
+ */
+inline void trackFree(int kind, size_t bytes);
+
+
+/* getMemoryUsage():
+ * 	Gets the memory counted for one part of the program.
+ * args:
+ * 	@kind: The part of the program (MEMORY_*).
+ * 	@usage: Location to store the counts.
+ * return:
+ * 	void
+ */
+void getMemoryUsage(int kind, MemoryUsage& usage);
+
+
+/* reportMemoryUsage():
+ * 	Prints the counts for every part of the program, if accounting
+ * 	is on.
+ * args:
+ * 	@out: The stream to print to.
+ * return:
+ * 	void
+ */
+void reportMemoryUsage(std::ostream& out);
+
+#include "MemoryStats.cpp"
+
+#endif
@@ -0,0 +1,189 @@
+/* ModelEval.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for evaluating several skin models in one pass.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <stdlib.h>
+#include <vector>
+
+#include "image.h"
+#include "ModelEval.h"
+#include "ColourSpace.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+#include "SkinModel.h"
+#include "SkinRegion.h"
+
+
+// Functions
+
+/* prepareModelEvaluation():
+ * 	Sets up the evaluation of a model with empty results.
+ * args:
+ * 	@model: The model to evaluate.
+ * 	@thresholds: The thresholds to count results at (any order;
+ * 		stored ascending).
+ * 	@eval: Location to store the evaluation.
+ * return:
+ * 	void
+ */
+void prepareModelEvaluation(const SkinModel& model, const std::vector<float>& thresholds,
+	ModelEvaluation& eval) {
+	ConfusionMatrix empty = { 0, 0, 0, 0 };
+
+	eval.model = model;
+	eval.thresholds = thresholds;
+	std::sort(eval.thresholds.begin(), eval.thresholds.end());
+	eval.counts.assign(eval.thresholds.size(), empty);
+	eval.mask = NULL;
+}
+
+
+/* evaluateModels():
+ * 	Classifies an image with every model in one pass. Each pixel's
+ * 	colour features are found once per colour scheme and its score
+ * 	once per model, however many thresholds there are. Results are
+ * 	added to each evaluation's counts, and masks are written for
+ * 	evaluations that have one. Rows are split across threads.
+ * args:
+ * 	@image: The image to classify.
+ * 	@ref: The reference image (white or red=skin), or NULL to only
+ * 		write masks.
+ * 	@evals: The models to evaluate.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void evaluateModels(ImageType& image, ImageType* ref, std::vector<ModelEvaluation>& evals,
+	int threads) {
+	int rows, cols, levels, refRows, refCols;
+	size_t count = evals.size();
+	bool needed[2] = { false, false };
+	std::vector<SkinPrefilter> filters(count);
+	std::vector<std::vector<long> > skinBuckets(count), otherBuckets(count);
+	std::mutex lock;
+
+	image.getImageInfo(rows, cols, levels);
+	if(ref != NULL) {
+		ref->getImageInfo(refRows, refCols, levels);
+		if(rows != refRows || cols != refCols) {
+			std::cout << "Error: Image and reference image differ in size" << std::endl;
+			exit(1);
+		}
+	}
+
+	// A pixel outside the box of the lowest threshold scores below every threshold
+	for(size_t m = 0; m < count; m++) {
+		SkinModel lowest = evals[m].model;
+		if(!evals[m].thresholds.empty() && evals[m].thresholds[0] < lowest.t) {
+			lowest.t = evals[m].thresholds[0];
+		}
+		prepareSkinPrefilter(lowest, filters[m]);
+		needed[evals[m].model.isRGB] = true;
+		skinBuckets[m].assign(evals[m].thresholds.size() + 1, 0);
+		otherBuckets[m].assign(evals[m].thresholds.size() + 1, 0);
+	}
+
+	// Bucket k holds pixels scoring above exactly k thresholds
+	parallelFor(rows, threads, [&](int begin, int end) {
+		std::vector<float> x[2][2];
+		std::vector<std::vector<long> > skin(count), other(count);
+		for(int c = 0; c < 2; c++) {
+			x[c][0].resize(needed[c] ? cols : 0);
+			x[c][1].resize(needed[c] ? cols : 0);
+		}
+		for(size_t m = 0; m < count; m++) {
+			skin[m].assign(evals[m].thresholds.size() + 1, 0);
+			other[m].assign(evals[m].thresholds.size() + 1, 0);
+		}
+
+		for(int i = begin; i < end; i++) {
+			const int* row = image.getRow(i);
+			const int* refRow = ref != NULL ? ref->getRow(i) : NULL;
+
+			for(int c = 0; c < 2; c++) {
+				if(needed[c]) {
+					featuresForPixels(c == 1, row, cols, x[c][0].data(), x[c][1].data());
+				}
+			}
+
+			for(size_t m = 0; m < count; m++) {
+				const SkinModel& model = evals[m].model;
+				const std::vector<float>& thresholds = evals[m].thresholds;
+				const float* x0 = x[model.isRGB][0].data();
+				const float* x1 = x[model.isRGB][1].data();
+				int* maskRow = evals[m].mask != NULL ? evals[m].mask->getRow(i) : NULL;
+
+				for(int j = 0; j < cols; j++) {
+					bool isSkin = false;
+					long above = 0;
+
+					if(passesSkinPrefilter(row[j*3], row[j*3+1], row[j*3+2], filters[m])) {
+						float score = scoreForFeatures(x0[j], x1[j], model);
+						isSkin = score > model.t;
+						above = std::lower_bound(thresholds.begin(), thresholds.end(), score)
+							- thresholds.begin();
+					}
+
+					if(maskRow != NULL) {
+						int level = isSkin ? 255 : 0;
+						maskRow[j*3] = level;
+						maskRow[j*3+1] = level;
+						maskRow[j*3+2] = level;
+					}
+					if(refRow != NULL) {
+						if(isSkinLabel(refRow[j*3], refRow[j*3+1], refRow[j*3+2])) {
+							skin[m][above]++;
+						}
+						else {
+							other[m][above]++;
+						}
+					}
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> hold(lock);
+		for(size_t m = 0; m < count; m++) {
+			for(size_t k = 0; k < skin[m].size(); k++) {
+				skinBuckets[m][k] += skin[m][k];
+				otherBuckets[m][k] += other[m][k];
+			}
+		}
+	});
+
+	if(ref == NULL) {
+		return;
+	}
+
+	// Threshold t_k accepts every bucket above k
+	for(size_t m = 0; m < count; m++) {
+		size_t steps = evals[m].thresholds.size();
+		long skinBelow = 0, otherBelow = 0, skinTotal = 0, otherTotal = 0;
+
+		for(size_t k = 0; k <= steps; k++) {
+			skinTotal += skinBuckets[m][k];
+			otherTotal += otherBuckets[m][k];
+		}
+		for(size_t k = 0; k < steps; k++) {
+			skinBelow += skinBuckets[m][k];
+			otherBelow += otherBuckets[m][k];
+			ConfusionMatrix& counts = evals[m].counts[k];
+			counts.tp += skinTotal - skinBelow;
+			counts.fn += skinBelow;
+			counts.fp += otherTotal - otherBelow;
+			counts.tn += otherBelow;
+		}
+	}
+}
@@ -0,0 +1,76 @@
+/* ModelEval.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for evaluating several skin models, each at
+ * 	several thresholds, in a single pass over each image.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef MODELEVAL_H_
+#define MODELEVAL_H_
+
+#include <vector>
+
+#include "image.h"
+#include "SkinModel.h"
+
+/* ConfusionMatrix:
+ * 	Pixel counts of a classification against a reference.
+ */
+struct ConfusionMatrix {
+	long tp;     // tp: Skin pixels classified as skin.
+	long fp;     // fp: Other pixels classified as skin.
+	long tn;     // tn: Other pixels classified as not skin.
+	long fn;     // fn: Skin pixels classified as not skin.
+};
+
+/* ModelEvaluation:
+ * 	One model being evaluated and its results so far.
+ */
+struct ModelEvaluation {
+	SkinModel model;                       // model: The model; its own threshold decides the mask.
+	std::vector<float> thresholds;         // thresholds: Thresholds to count results at, ascending.
+	std::vector<ConfusionMatrix> counts;   // counts: Results at each threshold, summed over images.
+	ImageType* mask;                       // mask: Image to output classified pixels to, or NULL.
+};
+
+
+/* prepareModelEvaluation():
+ * 	Sets up the evaluation of a model with empty results.
+ * args:
+ * 	@model: The model to evaluate.
+ * 	@thresholds: The thresholds to count results at (any order;
+ * 		stored ascending).
+ * 	@eval: Location to store the evaluation.
+ * return:
+ * 	void
+ */
+void prepareModelEvaluation(const SkinModel& model, const std::vector<float>& thresholds,
+	ModelEvaluation& eval);
+
+
+/* evaluateModels():
+ * 	Classifies an image with every model in one pass. Each pixel's
+ * 	colour features are found once per colour scheme and its score
+ * 	once per model, however many thresholds there are. Results are
+ * 	added to each evaluation's counts, and masks are written for
+ * 	evaluations that have one. Rows are split across threads.
+ * args:
+ * 	@image: The image to classify.
+ * 	@ref: The reference image (white or red=skin), or NULL to only
+ * 		write masks.
+ * 	@evals: The models to evaluate.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void evaluateModels(ImageType& image, ImageType* ref, std::vector<ModelEvaluation>& evals,
+	int threads = 0);
+
+#include "ModelEval.cpp"
+
+#endif
@@ -0,0 +1,460 @@
+/* ModelStats.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for training skin models from sufficient statistics.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "PlanarImage.h"
+#include "ReadImage.h"
+#include "ModelStats.h"
+#include "ColourSpace.h"
+#include "MemoryStats.h"
+#include "CreateModel.h"
+#include "Parallel.h"
+#include "SkinModel.h"
+
+
+// Functions
+
+/* clearFeatureStats():
+ * 	Empties a set of statistics.
+ * args:
+ * 	@stats: The statistics to clear.
+ * return:
+ * 	void
+ */
+void clearFeatureStats(FeatureStats& stats) {
+	stats.n = 0;
+	stats.s0 = 0;
+	stats.s1 = 0;
+	stats.s00 = 0;
+	stats.s01 = 0;
+	stats.s11 = 0;
+}
+
+
+/* addFeatureSample():
+ * 	Folds one sample into a set of statistics.
+ * args:
+ * 	@stats: The statistics to update.
+ * 	@x0: The first feature.
+ * 	@x1: The second feature.
+ * return:
+ * 	void
+ */
+inline void addFeatureSample(FeatureStats& stats, double x0, double x1) {
+	stats.n += 1;
+	stats.s0 += x0;
+	stats.s1 += x1;
+	stats.s00 += x0 * x0;
+	stats.s01 += x0 * x1;
+	stats.s11 += x1 * x1;
+}
+
+
+/* mergeFeatureStats():
+ * 	Adds (or takes away) one set of statistics to another.
+ * args:
+ * 	@into: The statistics to update.
+ * 	@from: The statistics to add.
+ * 	@sign: 1 to add, -1 to take away.
+ * return:
+ * 	void
+ */
+void mergeFeatureStats(FeatureStats& into, const FeatureStats& from, double sign) {
+	into.n += sign * from.n;
+	into.s0 += sign * from.s0;
+	into.s1 += sign * from.s1;
+	into.s00 += sign * from.s00;
+	into.s01 += sign * from.s01;
+	into.s11 += sign * from.s11;
+}
+
+
+/* meanCovForStats():
+ * 	Calculates the sample mean and unbiased sample covariance.
+ * args:
+ * 	@stats: The statistics of the samples (at least two).
+ * 	@mu: Location to store the mean.
+ * 	@cov: Location to store the covariance matrix.
+ * return:
+ * 	void
+ */
+void meanCovForStats(const FeatureStats& stats, float mu[2], float cov[2][2]) {
+	double m0 = stats.s0 / stats.n;
+	double m1 = stats.s1 / stats.n;
+
+	mu[0] = m0;
+	mu[1] = m1;
+	cov[0][0] = (stats.s00 - stats.s0 * m0) / (stats.n - 1);
+	cov[0][1] = (stats.s01 - stats.s0 * m1) / (stats.n - 1);
+	cov[1][0] = cov[0][1];
+	cov[1][1] = (stats.s11 - stats.s1 * m1) / (stats.n - 1);
+}
+
+
+/* isSkinLabel():
+ * 	Tests whether a reference pixel marks skin (white, or the red
+ * 	used by some of the reference images).
+ * args:
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * return:
+ * 	bool: true if skin.
+ */
+inline bool isSkinLabel(int r, int g, int b) {
+	return (r == 255 && g == 255 && b == 255) || (r == 252 && g == 3 && b == 3);
+}
+
+
+/* clearImageStats():
+ * 	Empties the counts and statistics of an image pair.
+ * args:
+ * 	@stats: The statistics to clear.
+ * return:
+ * 	void
+ */
+void clearImageStats(ImageStats& stats) {
+	stats.skinCount = 0;
+	stats.totalCount = 0;
+	for(int c = 0; c < 2; c++) {
+		clearFeatureStats(stats.skin[c]);
+		clearFeatureStats(stats.other[c]);
+	}
+}
+
+
+/* statsForImages():
+ * 	Gathers the statistics of a training image and its reference
+ * 	in one pass over the pixels, for both colour schemes at once.
+ * 	The pixels are read as planes; interleaved images are split
+ * 	first. Rows are split across threads; the result does not
+ * 	depend on the number of threads.
+ * args:
+ * 	@train: The training image.
+ * 	@ref: The reference image (same size).
+ * 	@stats: Location to store the statistics.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void statsForImages(PlanarImageType& train, PlanarImageType& ref, ImageStats& stats, int threads) {
+	int rows, cols, levels, refRows, refCols;
+
+	train.getImageInfo(rows, cols, levels);
+	ref.getImageInfo(refRows, refCols, levels);
+	if(rows != refRows || cols != refCols) {
+		std::cout << "Error: Training and reference images differ in size" << std::endl;
+		exit(1);
+	}
+
+	const unsigned char* plane[3] = { train.getPlane(0), train.getPlane(1), train.getPlane(2) };
+	const unsigned char* label[3] = { ref.getPlane(0), ref.getPlane(1), ref.getPlane(2) };
+
+	// Gather each row separately, then sum in row order
+	std::vector<ImageStats> rowStats(rows);
+	trackAlloc(MEMORY_MODEL, rows * sizeof(ImageStats));
+	parallelFor(rows, threads, [&](int begin, int end) {
+		std::vector<float> x[2][2];
+		for(int c = 0; c < 2; c++) {
+			x[c][0].resize(cols);
+			x[c][1].resize(cols);
+		}
+
+		for(int i = begin; i < end; i++) {
+			size_t base = (size_t)i * cols;
+			ImageStats& row = rowStats[i];
+
+			clearImageStats(row);
+			for(int c = 0; c < 2; c++) {
+				featuresForPlanes(c == 1, plane[0] + base, plane[1] + base, plane[2] + base,
+					cols, x[c][0].data(), x[c][1].data());
+			}
+
+			for(int j = 0; j < cols; j++) {
+				bool skin = isSkinLabel(label[0][base + j], label[1][base + j], label[2][base + j]);
+				row.skinCount += skin;
+				for(int c = 0; c < 2; c++) {
+					addFeatureSample(skin ? row.skin[c] : row.other[c], x[c][0][j], x[c][1][j]);
+				}
+			}
+			row.totalCount = cols;
+		}
+	});
+
+	clearImageStats(stats);
+	for(int i = 0; i < rows; i++) {
+		stats.skinCount += rowStats[i].skinCount;
+		stats.totalCount += rowStats[i].totalCount;
+		for(int c = 0; c < 2; c++) {
+			mergeFeatureStats(stats.skin[c], rowStats[i].skin[c]);
+			mergeFeatureStats(stats.other[c], rowStats[i].other[c]);
+		}
+	}
+	trackFree(MEMORY_MODEL, rows * sizeof(ImageStats));
+}
+
+void statsForImages(ImageType& train, ImageType& ref, ImageStats& stats, int threads) {
+	PlanarImageType trainPlanes, refPlanes;
+
+	toPlanar(train, trainPlanes);
+	toPlanar(ref, refPlanes);
+	statsForImages(trainPlanes, refPlanes, stats, threads);
+}
+
+
+/* statsForImagePairs():
+ * 	Gathers the statistics of several training images and their
+ * 	references. Each image is decoded once, and one pass over its
+ * 	pixels fills the counts and both colour schemes.
+ * args:
+ * 	@trainFNames: The paths of the training images.
+ * 	@refFNames: The paths of the matching reference images.
+ * 	@count: The number of image pairs.
+ * 	@stats: Location to store the combined statistics.
+ * return:
+ * 	void
+ */
+void statsForImagePairs(char* trainFNames[], char* refFNames[], int count, ImageStats& stats) {
+	clearImageStats(stats);
+
+	for(int k = 0; k < count; k++) {
+		ImageType train, ref;
+		ImageStats pair;
+
+		getImage(trainFNames[k], train);
+		getImage(refFNames[k], ref);
+		statsForImages(train, ref, pair);
+
+		stats.skinCount += pair.skinCount;
+		stats.totalCount += pair.totalCount;
+		for(int c = 0; c < 2; c++) {
+			mergeFeatureStats(stats.skin[c], pair.skin[c]);
+			mergeFeatureStats(stats.other[c], pair.other[c]);
+		}
+	}
+}
+
+
+/* addCheckpointImage():
+ * 	Reads an image pair and folds its statistics into a checkpoint.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * 	@trainFName: The path of the training image.
+ * 	@refFName: The path of the reference image.
+ * return:
+ * 	void
+ */
+void addCheckpointImage(StatsCheckpoint& checkpoint, char trainFName[], char refFName[]) {
+	PlanarImageType train, ref;
+	ImageStats stats;
+
+	for(size_t k = 0; k < checkpoint.images.size(); k++) {
+		if(checkpoint.images[k].trainFile == trainFName) {
+			std::cout << "Error: " << trainFName << " is already in the checkpoint" << std::endl;
+			exit(1);
+		}
+	}
+
+	readImagePPMPlanar(trainFName, train);
+	readImagePPMPlanar(refFName, ref);
+	statsForImages(train, ref, stats);
+	stats.trainFile = trainFName;
+	stats.refFile = refFName;
+
+	checkpoint.images.push_back(stats);
+	checkpoint.total.skinCount += stats.skinCount;
+	checkpoint.total.totalCount += stats.totalCount;
+	for(int c = 0; c < 2; c++) {
+		mergeFeatureStats(checkpoint.total.skin[c], stats.skin[c]);
+		mergeFeatureStats(checkpoint.total.other[c], stats.other[c]);
+	}
+}
+
+
+/* removeCheckpointImage():
+ * 	Takes the statistics of an earlier added image out of a
+ * 	checkpoint. The image itself is not read.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * 	@trainFName: The path the training image was added with.
+ * return:
+ * 	bool: true if the image was found and removed.
+ */
+bool removeCheckpointImage(StatsCheckpoint& checkpoint, char trainFName[]) {
+	for(size_t k = 0; k < checkpoint.images.size(); k++) {
+		if(checkpoint.images[k].trainFile == trainFName) {
+			checkpoint.images.erase(checkpoint.images.begin() + k);
+
+			// Resum rather than subtract so no rounding is left behind
+			sumCheckpointStats(checkpoint);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/* sumCheckpointStats():
+ * 	Recalculates the totals of a checkpoint from its images.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * return:
+ * 	void
+ */
+void sumCheckpointStats(StatsCheckpoint& checkpoint) {
+	clearImageStats(checkpoint.total);
+
+	for(size_t k = 0; k < checkpoint.images.size(); k++) {
+		const ImageStats& stats = checkpoint.images[k];
+		checkpoint.total.skinCount += stats.skinCount;
+		checkpoint.total.totalCount += stats.totalCount;
+		for(int c = 0; c < 2; c++) {
+			mergeFeatureStats(checkpoint.total.skin[c], stats.skin[c]);
+			mergeFeatureStats(checkpoint.total.other[c], stats.other[c]);
+		}
+	}
+}
+
+
+/* loadStatsCheckpoint():
+ * 	Reads a checkpoint written by saveStatsCheckpoint().
+ * args:
+ * 	@fName: The path to the checkpoint file.
+ * 	@checkpoint: Location to store the checkpoint.
+ * return:
+ * 	bool: false if the file does not exist (checkpoint left empty).
+ */
+bool loadStatsCheckpoint(char fName[], StatsCheckpoint& checkpoint) {
+	std::string key, space;
+	std::ifstream inFile(fName);
+
+	checkpoint.images.clear();
+	clearImageStats(checkpoint.total);
+	if(!inFile.is_open()) {
+		return false;
+	}
+
+	// Read each keyed line
+	while(inFile >> key) {
+		if(key[0] == '#') {
+			std::getline(inFile, key);
+		}
+		else if(key == "image") {
+			ImageStats stats;
+			clearImageStats(stats);
+			inFile >> stats.trainFile >> stats.refFile >> stats.skinCount >> stats.totalCount;
+			checkpoint.images.push_back(stats);
+		}
+		else if((key == "skin" || key == "other") && !checkpoint.images.empty()) {
+			inFile >> space;
+			ImageStats& stats = checkpoint.images.back();
+			FeatureStats& f = (key == "skin" ? stats.skin : stats.other)[space == "rgb"];
+			inFile >> f.n >> f.s0 >> f.s1 >> f.s00 >> f.s01 >> f.s11;
+		}
+		else {
+			break;
+		}
+	}
+
+	if(inFile.fail() && !inFile.eof()) {
+		std::cout << "Error: Invalid checkpoint file "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	sumCheckpointStats(checkpoint);
+	return true;
+}
+
+
+/* saveStatsCheckpoint():
+ * 	Writes a checkpoint to a file. The file is replaced in one
+ * 	step, so an interrupted save leaves the old checkpoint intact.
+ * args:
+ * 	@fName: The path to the checkpoint file.
+ * 	@checkpoint: The checkpoint to write.
+ * return:
+ * 	void
+ */
+void saveStatsCheckpoint(char fName[], const StatsCheckpoint& checkpoint) {
+	const char* names[2] = { "ycc", "rgb" };
+	std::string tmpName = std::string(fName) + ".tmp";
+	std::ofstream outFile(tmpName.c_str());
+
+	if(!outFile.is_open()) {
+		std::cout << "Error: Could not open "
+			<< tmpName
+			<< std::endl;
+		exit(1);
+	}
+
+	// Enough digits for the sums to read back exactly
+	outFile << std::setprecision(17);
+	outFile << "# Skin statistics checkpoint" << std::endl;
+	for(size_t k = 0; k < checkpoint.images.size(); k++) {
+		const ImageStats& stats = checkpoint.images[k];
+		outFile << "image " << stats.trainFile << " " << stats.refFile << " "
+			<< stats.skinCount << " " << stats.totalCount << std::endl;
+		for(int c = 1; c >= 0; c--) {
+			const FeatureStats* sets[2] = { &stats.skin[c], &stats.other[c] };
+			for(int s = 0; s < 2; s++) {
+				const FeatureStats& f = *sets[s];
+				outFile << (s == 0 ? "skin " : "other ") << names[c] << " "
+					<< f.n << " " << f.s0 << " " << f.s1 << " "
+					<< f.s00 << " " << f.s01 << " " << f.s11 << std::endl;
+			}
+		}
+	}
+
+	outFile.close();
+	if(outFile.fail() || rename(tmpName.c_str(), fName) != 0) {
+		std::cout << "Error: Could not write "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+}
+
+
+/* modelForStats():
+ * 	Builds a skin model from the statistics of image pairs.
+ * args:
+ * 	@stats: The combined statistics.
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@t: The threshold to classify with.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void modelForStats(const ImageStats& stats, bool isRGB, float t, SkinModel& model) {
+	if(stats.skin[isRGB].n < 2) {
+		std::cout << "Error: Too few skin pixels to build a model" << std::endl;
+		exit(1);
+	}
+
+	model.isRGB = isRGB;
+	model.prior = (float)stats.skinCount / stats.totalCount;
+	meanCovForStats(stats.skin[isRGB], model.mu, model.cov);
+	model.t = t;
+	prepareSkinModel(model);
+}
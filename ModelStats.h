@@ -0,0 +1,235 @@
+/* ModelStats.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for training skin models from sufficient
+ * 	statistics (counts, sums and cross-products) instead of raw
+ * 	samples.
+ *
+ * 	A checkpoint keeps the statistics of every image pair it was
+ * 	built from, so a pair can be added or removed later without
+ * 	revisiting the others.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef MODELSTATS_H_
+#define MODELSTATS_H_
+
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "PlanarImage.h"
+#include "SkinModel.h"
+
+/* FeatureStats:
+ * 	Sufficient statistics of a set of 2D feature samples.
+ */
+struct FeatureStats {
+	double n;       // n: Number of samples.
+	double s0;      // s0: Sum of the first features.
+	double s1;      // s1: Sum of the second features.
+	double s00;     // s00: Sum of the first features squared.
+	double s01;     // s01: Sum of the products of both features.
+	double s11;     // s11: Sum of the second features squared.
+};
+
+/* ImageStats:
+ * 	Statistics of one training image and its reference. Arrays of
+ * 	two are indexed by colour scheme (1=RGB, 0=YCrCb).
+ */
+struct ImageStats {
+	std::string trainFile;  // trainFile: Path of the training image.
+	std::string refFile;    // refFile: Path of the reference image.
+	long skinCount;         // skinCount: Pixels labelled skin.
+	long totalCount;        // totalCount: Pixels in the image.
+	FeatureStats skin[2];   // skin: Features of skin pixels.
+	FeatureStats other[2];  // other: Features of every other pixel.
+};
+
+/* StatsCheckpoint:
+ * 	Every image a model was trained from and their combined totals.
+ */
+struct StatsCheckpoint {
+	std::vector<ImageStats> images;   // images: Statistics of each image pair.
+	ImageStats total;                 // total: Sum over every image pair.
+};
+
+
+/* clearFeatureStats():
+ * 	Empties a set of statistics.
+ * args:
+ * 	@stats: The statistics to clear.
+ * return:
+ * 	void
+ */
+void clearFeatureStats(FeatureStats& stats);
+
+
+/* addFeatureSample():
+ * 	Folds one sample into a set of statistics.
+ * args:
+ * 	@stats: The statistics to update.
+ * 	@x0: The first feature.
+ * 	@x1: The second feature.
+ * return:
+ * 	void
+ */
+inline void addFeatureSample(FeatureStats& stats, double x0, double x1);
+
+
+/* mergeFeatureStats():
+ * 	Adds (or takes away) one set of statistics to another.
+ * args:
+ * 	@into: The statistics to update.
+ * 	@from: The statistics to add.
+ * 	@sign: 1 to add, -1 to take away.
+ * return:
+ * 	void
+ */
+void mergeFeatureStats(FeatureStats& into, const FeatureStats& from, double sign = 1);
+
+
+/* meanCovForStats():
+ * 	Calculates the sample mean and unbiased sample covariance.
+ * args:
+ * 	@stats: The statistics of the samples (at least two).
+ * 	@mu: Location to store the mean.
+ * 	@cov: Location to store the covariance matrix.
+ * return:
+ * 	void
+ */
+void meanCovForStats(const FeatureStats& stats, float mu[2], float cov[2][2]);
+
+
+/* isSkinLabel():
+ * 	Tests whether a reference pixel marks skin (white, or the red
+ * 	used by some of the reference images).
+ * args:
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * return:
+ * 	bool: true if skin.
+ */
+inline bool isSkinLabel(int r, int g, int b);
+
+
+/* clearImageStats():
+ * 	Empties the counts and statistics of an image pair.
+ * args:
+ * 	@stats: The statistics to clear.
+ * return:
+ * 	void
+ */
+void clearImageStats(ImageStats& stats);
+
+
+/* statsForImages():
+ * 	Gathers the statistics of a training image and its reference
+ * 	in one pass over the pixels, for both colour schemes at once.
+ * 	The pixels are read as planes; interleaved images are split
+ * 	first. Rows are split across threads; the result does not
+ * 	depend on the number of threads.
+ * args:
+ * 	@train: The training image.
+ * 	@ref: The reference image (same size).
+ * 	@stats: Location to store the statistics.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void statsForImages(PlanarImageType& train, PlanarImageType& ref, ImageStats& stats, int threads = 0);
+void statsForImages(ImageType& train, ImageType& ref, ImageStats& stats, int threads = 0);
+
+
+/* statsForImagePairs():
+ * 	Gathers the statistics of several training images and their
+ * 	references. Each image is decoded once, and one pass over its
+ * 	pixels fills the counts and both colour schemes.
+ * args:
+ * 	@trainFNames: The paths of the training images.
+ * 	@refFNames: The paths of the matching reference images.
+ * 	@count: The number of image pairs.
+ * 	@stats: Location to store the combined statistics.
+ * return:
+ * 	void
+ */
+void statsForImagePairs(char* trainFNames[], char* refFNames[], int count, ImageStats& stats);
+
+
+/* addCheckpointImage():
+ * 	Reads an image pair and folds its statistics into a checkpoint.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * 	@trainFName: The path of the training image.
+ * 	@refFName: The path of the reference image.
+ * return:
+ * 	void
+ */
+void addCheckpointImage(StatsCheckpoint& checkpoint, char trainFName[], char refFName[]);
+
+
+/* removeCheckpointImage():
+ * 	Takes the statistics of an earlier added image out of a
+ * 	checkpoint. The image itself is not read.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * 	@trainFName: The path the training image was added with.
+ * return:
+ * 	bool: true if the image was found and removed.
+ */
+bool removeCheckpointImage(StatsCheckpoint& checkpoint, char trainFName[]);
+
+
+/* sumCheckpointStats():
+ * 	Recalculates the totals of a checkpoint from its images.
+ * args:
+ * 	@checkpoint: The checkpoint to update.
+ * return:
+ * 	void
+ */
+void sumCheckpointStats(StatsCheckpoint& checkpoint);
+
+
+/* loadStatsCheckpoint():
+ * 	Reads a checkpoint written by saveStatsCheckpoint().
+ * args:
+ * 	@fName: The path to the checkpoint file.
+ * 	@checkpoint: Location to store the checkpoint.
+ * return:
+ * 	bool: false if the file does not exist (checkpoint left empty).
+ */
+bool loadStatsCheckpoint(char fName[], StatsCheckpoint& checkpoint);
+
+
+/* saveStatsCheckpoint():
+ * 	Writes a checkpoint to a file. The file is replaced in one
+ * 	step, so an interrupted save leaves the old checkpoint intact.
+ * args:
+ * 	@fName: The path to the checkpoint file.
+ * 	@checkpoint: The checkpoint to write.
+ * return:
+ * 	void
+ */
+void saveStatsCheckpoint(char fName[], const StatsCheckpoint& checkpoint);
+
+
+/* modelForStats():
+ * 	Builds a skin model from the statistics of image pairs.
+ * args:
+ * 	@stats: The combined statistics.
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@t: The threshold to classify with.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void modelForStats(const ImageStats& stats, bool isRGB, float t, SkinModel& model);
+
+#include "ModelStats.cpp"
+
+#endif
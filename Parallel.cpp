@@ -0,0 +1,467 @@
+/* Parallel.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for splitting work across threads.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <dirent.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Parallel.h"
+
+#define STEAL_DELAY_US 500   // Wait before a caller runs other nodes' bands.
+
+
+// Variables
+
+/* PoolJob:
+ * 	One call to parallelFor(). Each band is claimed once, by a
+ * 	worker or by the caller.
+ */
+struct PoolJob {
+	const std::function<void(int, int)>* body;      // body: The function to run.
+	int count;                                      // count: Items in the range.
+	int bands;                                      // bands: Bands the range is split into.
+	std::unique_ptr<std::atomic<bool>[]> taken;     // taken: Whether each band is claimed.
+	std::atomic<int> remaining;                     // remaining: Bands not yet finished.
+	std::mutex lock;
+	std::condition_variable done;
+};
+
+/* PoolTicket:
+ * 	A queued band. Tickets for bands the caller already ran are
+ * 	skipped when popped.
+ */
+struct PoolTicket {
+	std::shared_ptr<PoolJob> job;   // job: The call the band belongs to.
+	int band;                       // band: The band.
+};
+
+/* NodeQueue:
+ * 	The bands waiting to run on one node.
+ */
+struct NodeQueue {
+	std::mutex lock;
+	std::deque<PoolTicket> tickets;
+};
+
+/* ThreadPool:
+ * 	The workers, the CPUs of each node, and the queue of each node.
+ */
+struct ThreadPool {
+	std::vector<std::vector<int> > nodeCpus;        // nodeCpus: Usable CPUs of each node.
+	std::vector<int> cpuNode;                       // cpuNode: Node of each CPU, or -1.
+	std::vector<std::unique_ptr<NodeQueue> > queues;
+	std::vector<std::thread> workers;
+	std::vector<int> nodeWorkers;                   // nodeWorkers: Workers on each node.
+	std::mutex sleepLock;
+	std::condition_variable wake;
+	long pending;                                   // pending: Tickets queued (under sleepLock).
+};
+
+std::mutex poolStartLock;
+std::atomic<ThreadPool*> threadPool(NULL);
+int threadPinning = -1;
+
+
+// Functions
+
+/* defaultThreadCount():
+ * 	Gets the number of threads to use when none is requested.
+ * return:
+ * 	int: The number of hardware threads, or 1 if unknown.
+ */
+int defaultThreadCount() {
+	unsigned int n = std::thread::hardware_concurrency();
+	return n == 0 ? 1 : (int)n;
+}
+
+
+/* setThreadPinning():
+ * 	Chooses how pool workers are tied to CPUs. Takes effect only
+ * 	if called before the pool starts. Otherwise the SKIN_PIN
+ * 	environment variable ("none", "node" or "core") decides, and by
+ * 	default workers are tied to their node when there is more than
+ * 	one node.
+ * args:
+ * 	@mode: One of THREAD_PIN_*.
+ * return:
+ * 	void
+ */
+void setThreadPinning(int mode) {
+	std::lock_guard<std::mutex> guard(poolStartLock);
+	threadPinning = mode;
+}
+
+
+/* parseCpuList():
+ * 	Reads a kernel CPU list such as "0-3,8,10-11".
+ * args:
+ * 	@text: The list.
+ * 	@cpus: Location to add the CPUs to.
+ * return:
+ * 	void
+ */
+void parseCpuList(const std::string& text, std::vector<int>& cpus) {
+	size_t pos = 0;
+
+	while(pos < text.size()) {
+		size_t next = text.find(',', pos);
+		std::string item = text.substr(pos, next == std::string::npos ? std::string::npos : next - pos);
+		size_t dash = item.find('-');
+		int first = atoi(item.c_str());
+		int last = dash == std::string::npos ? first : atoi(item.c_str() + dash + 1);
+
+		for(int cpu = first; cpu <= last && !item.empty(); cpu++) {
+			cpus.push_back(cpu);
+		}
+		if(next == std::string::npos) {
+			break;
+		}
+		pos = next + 1;
+	}
+}
+
+
+/* readTopology():
+ * 	Finds the usable CPUs of each NUMA node. Without a readable
+ * 	layout, every usable CPU is put on one node.
+ * args:
+ * 	@pool: The pool to fill in.
+ * return:
+ * 	void
+ */
+void readTopology(ThreadPool& pool) {
+	cpu_set_t allowed;
+	bool known = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+	DIR* dir = opendir("/sys/devices/system/node");
+	std::vector<std::pair<int, std::vector<int> > > nodes;
+
+	// Each nodeN directory lists its CPUs
+	if(dir != NULL) {
+		struct dirent* entry;
+		while((entry = readdir(dir)) != NULL) {
+			std::string name = entry->d_name;
+			if(name.size() < 5 || name.compare(0, 4, "node") != 0
+				|| name.find_first_not_of("0123456789", 4) != std::string::npos) {
+				continue;
+			}
+
+			std::ifstream list(("/sys/devices/system/node/" + name + "/cpulist").c_str());
+			std::string text;
+			std::vector<int> cpus, usable;
+			std::getline(list, text);
+			parseCpuList(text, cpus);
+			for(size_t k = 0; k < cpus.size(); k++) {
+				if(cpus[k] >= 0 && cpus[k] < CPU_SETSIZE && (!known || CPU_ISSET(cpus[k], &allowed))) {
+					usable.push_back(cpus[k]);
+				}
+			}
+			if(!usable.empty()) {
+				nodes.push_back(std::make_pair(atoi(name.c_str() + 4), usable));
+			}
+		}
+		closedir(dir);
+	}
+	std::sort(nodes.begin(), nodes.end());
+
+	if(nodes.empty()) {
+		std::vector<int> cpus;
+		for(int cpu = 0; cpu < CPU_SETSIZE && known; cpu++) {
+			if(CPU_ISSET(cpu, &allowed)) {
+				cpus.push_back(cpu);
+			}
+		}
+		nodes.push_back(std::make_pair(0, cpus));
+	}
+
+	pool.cpuNode.assign(CPU_SETSIZE, -1);
+	for(size_t n = 0; n < nodes.size(); n++) {
+		pool.nodeCpus.push_back(nodes[n].second);
+		for(size_t k = 0; k < nodes[n].second.size(); k++) {
+			pool.cpuNode[nodes[n].second[k]] = n;
+		}
+	}
+}
+
+
+/* currentNode():
+ * 	Finds the node the calling thread is running on.
+ * args:
+ * 	@pool: The pool.
+ * return:
+ * 	int: The node, or 0 if unknown.
+ */
+int currentNode(const ThreadPool& pool) {
+	int cpu = sched_getcpu();
+	return cpu >= 0 && cpu < (int)pool.cpuNode.size() && pool.cpuNode[cpu] >= 0 ? pool.cpuNode[cpu] : 0;
+}
+
+
+/* runBand():
+ * 	Runs one band of a job and signals the caller after the last.
+ * args:
+ * 	@job: The job.
+ * 	@band: The band, already claimed.
+ * return:
+ * 	void
+ */
+void runBand(PoolJob& job, int band) {
+	int begin = (int)((long)job.count * band / job.bands);
+	int end = (int)((long)job.count * (band + 1) / job.bands);
+
+	(*job.body)(begin, end);
+	if(job.remaining.fetch_sub(1) == 1) {
+		std::lock_guard<std::mutex> guard(job.lock);
+		job.done.notify_all();
+	}
+}
+
+
+/* popTicket():
+ * 	Takes a band from a node's queue, or from another node's if
+ * 	that one is empty.
+ * args:
+ * 	@pool: The pool.
+ * 	@node: The node to look at first.
+ * 	@ticket: Location to store the band.
+ * return:
+ * 	bool: true if a band was taken.
+ */
+bool popTicket(ThreadPool& pool, int node, PoolTicket& ticket) {
+	int nodes = pool.queues.size();
+
+	for(int k = 0; k < nodes; k++) {
+		NodeQueue& queue = *pool.queues[(node + k) % nodes];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if(queue.tickets.empty()) {
+			continue;
+		}
+
+		// Own bands from the front, stolen bands from the back
+		if(k == 0) {
+			ticket = queue.tickets.front();
+			queue.tickets.pop_front();
+		}
+		else {
+			ticket = queue.tickets.back();
+			queue.tickets.pop_back();
+		}
+		std::lock_guard<std::mutex> sleep(pool.sleepLock);
+		pool.pending--;
+		return true;
+	}
+
+	return false;
+}
+
+
+/* workerLoop():
+ * 	Ties a worker to its CPUs, then runs bands until the program
+ * 	ends.
+ * args:
+ * 	@pool: The pool.
+ * 	@node: The worker's node.
+ * 	@cpu: The worker's CPU.
+ * 	@pinning: One of THREAD_PIN_*.
+ * return:
+ * 	void
+ */
+void workerLoop(ThreadPool* pool, int node, int cpu, int pinning) {
+	if(pinning != THREAD_PIN_NONE) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if(pinning == THREAD_PIN_CORE) {
+			CPU_SET(cpu, &set);
+		}
+		else {
+			for(size_t k = 0; k < pool->nodeCpus[node].size(); k++) {
+				CPU_SET(pool->nodeCpus[node][k], &set);
+			}
+		}
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	}
+
+	while(true) {
+		PoolTicket ticket;
+		if(!popTicket(*pool, node, ticket)) {
+			std::unique_lock<std::mutex> sleep(pool->sleepLock);
+			pool->wake.wait(sleep, [pool] { return pool->pending > 0; });
+			continue;
+		}
+		if(!ticket.job->taken[ticket.band].exchange(true)) {
+			runBand(*ticket.job, ticket.band);
+		}
+	}
+}
+
+
+/* getThreadPool():
+ * 	Gets the pool, starting it on first use. One worker is started
+ * 	per hardware thread but one (the caller's); workers are spread
+ * 	over the nodes in proportion to their CPUs. The pool is never
+ * 	torn down, so exit() from any band is safe.
+ * return:
+ * 	ThreadPool&: The pool.
+ */
+ThreadPool& getThreadPool() {
+	ThreadPool* pool = threadPool.load(std::memory_order_acquire);
+	if(pool != NULL) {
+		return *pool;
+	}
+
+	std::lock_guard<std::mutex> guard(poolStartLock);
+	pool = threadPool.load(std::memory_order_relaxed);
+	if(pool != NULL) {
+		return *pool;
+	}
+
+	pool = new ThreadPool();
+	pool->pending = 0;
+	readTopology(*pool);
+	for(size_t n = 0; n < pool->nodeCpus.size(); n++) {
+		pool->queues.push_back(std::unique_ptr<NodeQueue>(new NodeQueue()));
+	}
+
+	int pinning = threadPinning;
+	if(pinning < 0) {
+		const char* mode = getenv("SKIN_PIN");
+		std::string name = mode != NULL ? mode : "";
+		pinning = name == "core" ? THREAD_PIN_CORE : name == "node" ? THREAD_PIN_NODE
+			: name == "none" ? THREAD_PIN_NONE
+			: pool->nodeCpus.size() > 1 ? THREAD_PIN_NODE : THREAD_PIN_NONE;
+	}
+
+	// Deal CPUs node by node; the caller stands in for the first
+	std::vector<int> cpus;
+	pool->nodeWorkers.assign(pool->nodeCpus.size(), 0);
+	for(size_t n = 0; n < pool->nodeCpus.size(); n++) {
+		cpus.insert(cpus.end(), pool->nodeCpus[n].begin(), pool->nodeCpus[n].end());
+	}
+	for(int w = 1; w < defaultThreadCount(); w++) {
+		int cpu = cpus.empty() ? -1 : cpus[w % cpus.size()];
+		int node = cpu < 0 ? 0 : pool->cpuNode[cpu];
+		pool->workers.push_back(std::thread(workerLoop, pool, node, cpu,
+			cpu < 0 ? THREAD_PIN_NONE : pinning));
+		pool->workers.back().detach();
+		pool->nodeWorkers[node]++;
+	}
+
+	threadPool.store(pool, std::memory_order_release);
+	return *pool;
+}
+
+
+/* numaNodeCount():
+ * 	Gets the number of NUMA nodes with CPUs this process may use.
+ * return:
+ * 	int: The node count (1 if the layout is unknown).
+ */
+int numaNodeCount() {
+	return getThreadPool().nodeCpus.size();
+}
+
+
+/* parallelFor():
+ * 	Splits the range [0, count) into contiguous bands and runs a
+ * 	function on each band on the thread pool. The calling thread
+ * 	also runs the bands of its own call queued on its node; bands
+ * 	of other nodes it runs only if their workers have not taken
+ * 	them shortly after. Returns once every band is done.
+ * args:
+ * 	@count: The number of items in the range (e.g. image rows).
+ * 	@threads: The number of bands to split the range into. Values
+ * 		less than 1 use defaultThreadCount().
+ * 	@body: The function to run as body(begin, end) for each band.
+ * return:
+ * 	void
+ */
+void parallelFor(int count, int threads, const std::function<void(int, int)>& body) {
+	if(count <= 0) {
+		return;
+	}
+	if(threads < 1) {
+		threads = defaultThreadCount();
+	}
+	if(threads > count) {
+		threads = count;
+	}
+	if(threads == 1) {
+		body(0, count);
+		return;
+	}
+
+	ThreadPool& pool = getThreadPool();
+	std::shared_ptr<PoolJob> job(new PoolJob());
+	int nodes = pool.queues.size();
+
+	job->body = &body;
+	job->count = count;
+	job->bands = threads;
+	job->taken.reset(new std::atomic<bool>[threads]);
+	for(int k = 0; k < threads; k++) {
+		job->taken[k] = false;
+	}
+	job->remaining = threads;
+
+	// Queue each band on its node, then wake the workers
+	if(!pool.workers.empty()) {
+		for(int k = 0; k < threads; k++) {
+			PoolTicket ticket = { job, k };
+			NodeQueue& queue = *pool.queues[(long)k * nodes / threads];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			queue.tickets.push_back(ticket);
+		}
+		{
+			std::lock_guard<std::mutex> sleep(pool.sleepLock);
+			pool.pending += threads;
+		}
+		pool.wake.notify_all();
+	}
+
+	// Run this node's unclaimed bands, and those of nodes without
+	// workers. Other calls' bands are left alone, so a caller holding
+	// a lock never runs work that needs it.
+	int home = currentNode(pool);
+	for(int k = 0; k < threads; k++) {
+		int node = (int)((long)k * nodes / threads);
+		if((node == home || pool.nodeWorkers[node] == 0) && !job->taken[k].exchange(true)) {
+			runBand(*job, k);
+		}
+	}
+
+	// Give other nodes' workers time to take their bands, then run any
+	// still waiting, so busy or blocked workers cannot stall the call
+	auto finished = [&job] { return job->remaining.load() == 0; };
+	std::unique_lock<std::mutex> wait(job->lock);
+	if(!job->done.wait_for(wait, std::chrono::microseconds(STEAL_DELAY_US), finished)) {
+		wait.unlock();
+		for(int k = 0; k < threads; k++) {
+			if(!job->taken[k].exchange(true)) {
+				runBand(*job, k);
+			}
+		}
+		wait.lock();
+	}
+	job->done.wait(wait, finished);
+}
@@ -0,0 +1,79 @@
+/* Parallel.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for splitting work across threads.
+ *
+ * 	Work runs on a pool of threads started on first use and kept
+ * 	for the life of the program. The pool reads the NUMA layout
+ * 	from /sys/devices/system/node and keeps one queue of bands per
+ * 	node; band k of n goes to node k*nodes/n, so the same split of
+ * 	rows always lands on the same node and rows first touched there
+ * 	stay local. Workers take bands from their own node and only
+ * 	steal from other nodes when theirs is empty; the caller runs
+ * 	its own node's bands and leaves the rest to their node's
+ * 	workers unless they are still waiting after a short delay.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <functional>
+
+#define THREAD_PIN_NONE 0    // Workers may run on any CPU.
+#define THREAD_PIN_NODE 1    // Each worker stays on the CPUs of its node.
+#define THREAD_PIN_CORE 2    // Each worker stays on one CPU.
+
+/* defaultThreadCount():
+ * 	Gets the number of threads to use when none is requested.
+ * return:
+ * 	int: The number of hardware threads, or 1 if unknown.
+ */
+int defaultThreadCount();
+
+
+/* setThreadPinning():
+ * 	Chooses how pool workers are tied to CPUs. Takes effect only
+ * 	if called before the pool starts. Otherwise the SKIN_PIN
+ * 	environment variable ("none", "node" or "core") decides, and by
+ * 	default workers are tied to their node when there is more than
+ * 	one node.
+ * args:
+ * 	@mode: One of THREAD_PIN_*.
+ * return:
+ * 	void
+ */
+void setThreadPinning(int mode);
+
+
+/* numaNodeCount():
+ * 	Gets the number of NUMA nodes with CPUs this process may use.
+ * return:
+ * 	int: The node count (1 if the layout is unknown).
+ */
+int numaNodeCount();
+
+
+/* parallelFor():
+ * 	Splits the range [0, count) into contiguous bands and runs a
+ * 	function on each band on the thread pool. The calling thread
+ * 	also runs the bands of its own call queued on its node; bands
+ * 	of other nodes it runs only if their workers have not taken
+ * 	them shortly after. Returns once every band is done.
+ * args:
+ * 	@count: The number of items in the range (e.g. image rows).
+ * 	@threads: The number of bands to split the range into. Values
+ * 		less than 1 use defaultThreadCount().
+ * 	@body: The function to run as body(begin, end) for each band.
+ * return:
+ * 	void
+ */
+void parallelFor(int count, int threads, const std::function<void(int, int)>& body);
+
+#include "Parallel.cpp"
+
+#endif
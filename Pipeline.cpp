@@ -0,0 +1,292 @@
+/* Pipeline.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for classifying batches of images with reading,
+ * 	classifying and writing overlapped on separate threads.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <chrono>
+#include <thread>
+
+#include "image.h"
+#include "rgb.h"
+#include "Pipeline.h"
+#include "ReadImageHeader.h"
+#include "WriteImage.h"
+#include "CreateModel.h"
+#include "ClassifySkin.h"
+#include "SkinRegion.h"
+
+
+// Classes
+
+/* BoundedQueue():
+ * 	Constructor for BoundedQueue.
+ * args:
+ * 	@capacity: Max items held at once (at least 1).
+ */
+template<typename T>
+BoundedQueue<T>::BoundedQueue(size_t capacity) :
+	capacity(capacity < 1 ? 1 : capacity), closed(false)
+{ }
+
+
+/* push():
+ * 	Adds an item to the back of the queue, waiting for room.
+ * args:
+ * 	@item: The item to add.
+ * return:
+ * 	true: if the item was added.
+ * 	false: if the queue is closed.
+ */
+template<typename T>
+bool BoundedQueue<T>::push(const T& item) {
+	std::unique_lock<std::mutex> guard(lock);
+	notFull.wait(guard, [this] { return items.size() < capacity || closed; });
+	if(closed) {
+		return false;
+	}
+	items.push_back(item);
+	notEmpty.notify_one();
+	return true;
+}
+
+
+/* pop():
+ * 	Removes the item at the front of the queue, waiting for one.
+ * args:
+ * 	@item: Location to store the item.
+ * return:
+ * 	true: if an item was popped.
+ * 	false: if the queue is closed and empty.
+ */
+template<typename T>
+bool BoundedQueue<T>::pop(T& item) {
+	std::unique_lock<std::mutex> guard(lock);
+	notEmpty.wait(guard, [this] { return !items.empty() || closed; });
+	if(items.empty()) {
+		return false;
+	}
+	item = items.front();
+	items.pop_front();
+	notFull.notify_one();
+	return true;
+}
+
+
+/* popBatch():
+ * 	Removes up to a number of items from the front of the queue,
+ * 	waiting for at least one.
+ * args:
+ * 	@out: Location to append the popped items to.
+ * 	@maxItems: The most items to pop.
+ * return:
+ * 	size_t: The number of items popped (0 once closed and empty).
+ */
+template<typename T>
+size_t BoundedQueue<T>::popBatch(std::vector<T>& out, size_t maxItems) {
+	std::unique_lock<std::mutex> guard(lock);
+	notEmpty.wait(guard, [this] { return !items.empty() || closed; });
+	size_t count = 0;
+	while(!items.empty() && count < maxItems) {
+		out.push_back(items.front());
+		items.pop_front();
+		count++;
+	}
+	notFull.notify_all();
+	return count;
+}
+
+
+/* close():
+ * 	Marks that no more items will be pushed and wakes all waiters.
+ * 	Later pushes fail.
+ * return:
+ * 	void
+ */
+template<typename T>
+void BoundedQueue<T>::close() {
+	std::lock_guard<std::mutex> guard(lock);
+	closed = true;
+	notEmpty.notify_all();
+	notFull.notify_all();
+}
+
+
+/* MemoryBudget():
+ * 	Constructor for MemoryBudget.
+ * args:
+ * 	@limit: Max bytes held at once.
+ */
+MemoryBudget::MemoryBudget(size_t limit) :
+	limit(limit), used(0)
+{ }
+
+
+/* acquire():
+ * 	Takes bytes from the budget, waiting until they fit.
+ * args:
+ * 	@bytes: The number of bytes to take.
+ * return:
+ * 	void
+ */
+void MemoryBudget::acquire(size_t bytes) {
+	std::unique_lock<std::mutex> guard(lock);
+	freed.wait(guard, [&] { return used == 0 || used + bytes <= limit; });
+	used += bytes;
+}
+
+
+/* release():
+ * 	Returns bytes to the budget.
+ * args:
+ * 	@bytes: The number of bytes to return.
+ * return:
+ * 	void
+ */
+void MemoryBudget::release(size_t bytes) {
+	std::lock_guard<std::mutex> guard(lock);
+	used -= bytes;
+	freed.notify_all();
+}
+
+
+// Functions
+
+/* PipelineItem:
+ * 	An image passed between pipeline stages.
+ */
+struct PipelineItem {
+	size_t index;                // index: Position of job in batch.
+	ImageType* image;            // image: The image read from disk.
+	ImageType* out;              // out: The classified image.
+	size_t bytes;                // bytes: Memory taken from the budget.
+	double work;                 // work: Seconds spent in the stages so far.
+	std::chrono::steady_clock::time_point start;
+};
+
+
+/* secondsSince():
+ * 	Gets the time passed since a point.
+ * args:
+ * 	@start: The point to measure from.
+ * return:
+ * 	double: The seconds passed.
+ */
+double secondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/* defaultPipelineOptions():
+ * 	Gets the options used when none are given.
+ * return:
+ * 	PipelineOptions: A depth of 2 and a 512 MiB memory budget.
+ */
+PipelineOptions defaultPipelineOptions() {
+	PipelineOptions opts;
+	opts.depth = 2;
+	opts.memoryBudget = (size_t)512 << 20;
+	return opts;
+}
+
+
+/* runPipeline():
+ * 	Classifies a batch of images. One thread reads images ahead of
+ * 	the classifier and another writes results behind it, so disk
+ * 	and CPU work overlap.
+ * args:
+ * 	@jobs: The images to classify. Timing results are stored back
+ * 		into each job.
+ * 	@opts: Queue depth and memory budget for backpressure.
+ * return:
+ * 	void
+ */
+void runPipeline(std::vector<PipelineJob>& jobs, const PipelineOptions& opts) {
+	// Variables
+	BoundedQueue<PipelineItem> loaded(opts.depth);
+	BoundedQueue<PipelineItem> classified(opts.depth);
+	MemoryBudget budget(opts.memoryBudget);
+
+	// Read stage: load images ahead of the classifier
+	std::thread reader([&] {
+		for(size_t k = 0; k < jobs.size(); k++) {
+			PipelineItem item;
+			int rows, cols, levels;
+			bool type;
+
+			// Reserve room for the image and its result before reading
+			item.index = k;
+			item.start = std::chrono::steady_clock::now();
+			readImageHeader((char*)jobs[k].inFile.c_str(), rows, cols, levels, type);
+			item.bytes = 2 * (size_t)rows * cols * 3 * sizeof(int);
+			budget.acquire(item.bytes);
+
+			// Stage times are kept apart from the waits between them.
+			// Each file is read once, so skip the image cache: a cached
+			// copy would sit outside the budget and never be used.
+			std::chrono::steady_clock::time_point read = std::chrono::steady_clock::now();
+			item.image = new ImageType(rows, cols, levels);
+			readImagePPM((char*)jobs[k].inFile.c_str(), *item.image);
+			item.out = NULL;
+			item.work = secondsSince(read);
+			loaded.push(item);
+		}
+		loaded.close();
+	});
+
+	// Write stage: save results behind the classifier
+	std::thread writer([&] {
+		PipelineItem item;
+		while(classified.pop(item)) {
+			PipelineJob& job = jobs[item.index];
+			std::chrono::steady_clock::time_point write = std::chrono::steady_clock::now();
+			writeImagePPM((char*)job.outFile.c_str(), *item.out);
+			delete item.out;
+			budget.release(item.bytes);
+
+			job.seconds = item.work + secondsSince(write);
+			job.waitSeconds = secondsSince(item.start) - job.seconds;
+		}
+	});
+
+	// Classify stage: runs on the calling thread
+	PipelineItem item;
+	while(loaded.pop(item)) {
+		PipelineJob& job = jobs[item.index];
+		int rows, cols, levels;
+		std::chrono::steady_clock::time_point classify = std::chrono::steady_clock::now();
+
+		item.image->getImageInfo(rows, cols, levels);
+		item.out = new ImageType(rows, cols, levels);
+		if(job.fixedModel != NULL) {
+			classifyForImageFixed(*item.image, *item.out, *job.fixedModel);
+		}
+		else if(job.model != NULL && job.blockSize > 0) {
+			classifyForImageBlocks(*item.image, *item.out, *job.model, job.blockSize);
+		}
+		else if(job.model != NULL) {
+			classifyForImage(*item.image, *item.out, *job.model);
+		}
+		else {
+			classifyForImage(*item.image, *item.out, job.t, job.isRGB);
+		}
+		job.pixels = (long)rows * cols;
+
+		delete item.image;
+		item.image = NULL;
+		item.work += secondsSince(classify);
+		classified.push(item);
+	}
+	classified.close();
+
+	reader.join();
+	writer.join();
+}
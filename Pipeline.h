@@ -0,0 +1,111 @@
+/* Pipeline.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for classifying batches of images with reading,
+ * 	classifying and writing overlapped on separate threads.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "image.h"
+#include "SkinModel.h"
+#include "FixedPoint.h"
+
+/* BoundedQueue:
+ * 	A first-in first-out queue shared between threads. Pushing blocks
+ * 	while the queue holds its capacity of items. Popping blocks until
+ * 	an item arrives or the queue is closed.
+ */
+template<typename T>
+class BoundedQueue {
+ public:
+	BoundedQueue(size_t capacity);
+	bool push(const T& item);
+	bool pop(T& item);
+	size_t popBatch(std::vector<T>& out, size_t maxItems);
+	void close();
+ private:
+	size_t capacity;             // capacity: Max items held at once.
+	bool closed;                 // closed: No more items will be pushed.
+	std::deque<T> items;         // items: Items waiting to be popped.
+	std::mutex lock;
+	std::condition_variable notFull, notEmpty;
+};
+
+/* MemoryBudget:
+ * 	Counts the bytes held by work in flight. Acquiring blocks while
+ * 	the request would go over the limit, unless nothing is held, so
+ * 	a single oversized item can still make progress.
+ */
+class MemoryBudget {
+ public:
+	MemoryBudget(size_t limit);
+	void acquire(size_t bytes);
+	void release(size_t bytes);
+ private:
+	size_t limit, used;          // limit: Max bytes; used: Bytes held.
+	std::mutex lock;
+	std::condition_variable freed;
+};
+
+/* PipelineJob:
+ * 	An image to classify and where to write the result.
+ */
+struct PipelineJob {
+	std::string inFile;          // inFile: Path to image to classify.
+	std::string outFile;         // outFile: Path to write classified image.
+	bool isRGB;                  // isRGB: Colour scheme (1=RGB, 0=YCrCb).
+	float t;                     // t: Threshold for classifying skin.
+	const SkinModel* model;      // model: Model to use instead, or NULL.
+	const FixedSkinModel* fixedModel; // fixedModel: Integer model to use instead, or NULL.
+	int blockSize;               // blockSize: Block size for coarse-to-fine, or 0.
+	double seconds;              // seconds: Time spent reading, classifying and writing.
+	double waitSeconds;          // waitSeconds: Time spent waiting on the budget and queues.
+	long pixels;                 // pixels: Number of pixels classified.
+};
+
+/* PipelineOptions:
+ * 	Limits on how far the pipeline runs ahead.
+ */
+struct PipelineOptions {
+	int depth;                   // depth: Images held between stages.
+	size_t memoryBudget;         // memoryBudget: Max bytes of images in flight.
+};
+
+
+/* defaultPipelineOptions():
+ * 	Gets the options used when none are given.
+ * return:
+ * 	PipelineOptions: A depth of 2 and a 512 MiB memory budget.
+ */
+PipelineOptions defaultPipelineOptions();
+
+
+/* runPipeline():
+ * 	Classifies a batch of images. One thread reads images ahead of
+ * 	the classifier and another writes results behind it, so disk
+ * 	and CPU work overlap.
+ * args:
+ * 	@jobs: The images to classify. Timing results are stored back
+ * 		into each job.
+ * 	@opts: Queue depth and memory budget for backpressure.
+ * return:
+ * 	void
+ */
+void runPipeline(std::vector<PipelineJob>& jobs, const PipelineOptions& opts);
+
+#include "Pipeline.cpp"
+
+#endif
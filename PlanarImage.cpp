@@ -0,0 +1,240 @@
+/* PlanarImage.cpp:
+ * 	Implementation file for PlanarImage.h.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include "image.h"
+#include "rgb.h"
+#include "PlanarImage.h"
+#include "MemoryStats.h"
+
+
+// Functions
+
+/* PlanarImageType():
+ * 	Default constructor for PlanarImageType. Holds no pixels.
+ */
+PlanarImageType::PlanarImageType() :
+	N(0), M(0), Q(0)
+{ }
+
+
+/* PlanarImageType():
+ * 	Constructor for PlanarImageType. Allocates zeroed planes.
+ * args:
+ *  @tmpN: Number of rows.
+ *  @tmpM: Number of columns.
+ *  @tmpQ: Max value possible for pixel values.
+ */
+PlanarImageType::PlanarImageType(int tmpN, int tmpM, int tmpQ) :
+	N(0), M(0), Q(0)
+{
+	setImageInfo(tmpN, tmpM, tmpQ);
+}
+
+
+/* PlanarImageType():
+ * 	Copy constructor for PlanarImageType.
+ * args:
+ *  @image: The image to copy.
+ */
+PlanarImageType::PlanarImageType(const PlanarImageType& image) :
+	N(image.N), M(image.M), Q(image.Q)
+{
+	for(int c = 0; c < 3; c++) {
+		planes[c] = image.planes[c];
+	}
+	trackAlloc(MEMORY_IMAGE, 3 * (size_t)N * M);
+}
+
+
+/* ~PlanarImageType():
+ * 	Destructor for PlanarImageType.
+ */
+PlanarImageType::~PlanarImageType()
+{
+	trackFree(MEMORY_IMAGE, 3 * (size_t)N * M);
+}
+
+
+/* getImageInfo():
+ * 	Gets the metadata information for the contained image.
+ * args:
+ * 	@rows: Location to output the number of rows in the image.
+ * 	@cols: Location to output the number of columns in the image.
+ * 	@levels: Location to output the maximum pixel value allowed.
+ * return:
+ * 	void
+ */
+void PlanarImageType::getImageInfo(int& rows, int& cols, int& levels)
+{
+	rows = N;
+	cols = M;
+	levels = Q;
+}
+
+
+/* setImageInfo():
+ * 	Sets the metadata information for the contained image and
+ * 	resizes the planes to match. Pixel values are zeroed.
+ * args:
+ * 	@rows: The number of rows to assign to image.
+ * 	@cols: The number of columns to assign to image.
+ * 	@levels: The maximum pixel value allowed.
+ * return:
+ * 	void
+ */
+void PlanarImageType::setImageInfo(int rows, int cols, int levels)
+{
+	trackFree(MEMORY_IMAGE, 3 * (size_t)N * M);
+	N = rows;
+	M = cols;
+	Q = levels;
+
+	for(int c = 0; c < 3; c++) {
+		planes[c].assign((size_t)N * M, 0);
+	}
+	trackAlloc(MEMORY_IMAGE, 3 * (size_t)N * M);
+}
+
+
+/* setPixelVal():
+ * 	Sets the pixel value at a given location.
+ * args:
+ * 	@i: The row to access.
+ * 	@j: The column to access.
+ * 	@val: The value to set the pixel value as.
+ * return:
+ * 	void
+ */
+void PlanarImageType::setPixelVal(int i, int j, RGB& val)
+{
+	size_t k = (size_t)i * M + j;
+	planes[0][k] = val.r;
+	planes[1][k] = val.g;
+	planes[2][k] = val.b;
+}
+
+
+/* getPixelVal():
+ * 	Get the pixel value at a given location.
+ * args:
+ * 	@i: The row to look for the pixel value.
+ * 	@j: The column to look for the pixel value.
+ * 	@val: Location to store the pixel value.
+ * return:
+ * 	void
+ */
+void PlanarImageType::getPixelVal(int i, int j, RGB& val)
+{
+	size_t k = (size_t)i * M + j;
+	val.r = planes[0][k];
+	val.g = planes[1][k];
+	val.b = planes[2][k];
+}
+
+
+/* getPlane():
+ * 	Gets the contiguous storage of one colour channel.
+ * args:
+ * 	@c: The channel (0=red, 1=green, 2=blue).
+ * return:
+ * 	unsigned char*: The channel's value for every pixel, row by row.
+ */
+unsigned char* PlanarImageType::getPlane(int c)
+{
+	return planes[c].data();
+}
+
+
+/* operator=():
+ * 	Modifies the left-hand object (self) by reassigning its values
+ * 	to match that of the right-hand object.
+ * args:
+ * 	@image: The source to copy values from.
+ * return:
+ * 	(*)this
+ */
+PlanarImageType& PlanarImageType::operator=(const PlanarImageType& image)
+{
+	if(this == &image) {
+		return *this;
+	}
+
+	trackFree(MEMORY_IMAGE, 3 * (size_t)N * M);
+	N = image.N;
+	M = image.M;
+	Q = image.Q;
+	for(int c = 0; c < 3; c++) {
+		planes[c] = image.planes[c];
+	}
+	trackAlloc(MEMORY_IMAGE, 3 * (size_t)N * M);
+
+	return *this;
+}
+
+
+/* toPlanar():
+ * 	Copies an interleaved RGB image into planar storage.
+ * args:
+ * 	@source: The image to copy.
+ * 	@dest: The image to store the copy in. Resized to match.
+ * return:
+ * 	void
+ */
+void toPlanar(ImageType& source, PlanarImageType& dest) {
+	int rows, cols, levels;
+
+	source.getImageInfo(rows, cols, levels);
+	dest.setImageInfo(rows, cols, levels);
+
+	unsigned char* r = dest.getPlane(0);
+	unsigned char* g = dest.getPlane(1);
+	unsigned char* b = dest.getPlane(2);
+
+	for(int i = 0; i < rows; i++) {
+		const int* row = source.getRow(i);
+		size_t base = (size_t)i * cols;
+		for(int j = 0; j < cols; j++) {
+			r[base + j] = row[j*3];
+			g[base + j] = row[j*3+1];
+			b[base + j] = row[j*3+2];
+		}
+	}
+}
+
+
+/* toInterleaved():
+ * 	Copies a planar image into interleaved RGB storage.
+ * args:
+ * 	@source: The image to copy.
+ * 	@dest: The image to store the copy in. Must already be sized.
+ * return:
+ * 	void
+ */
+void toInterleaved(PlanarImageType& source, ImageType& dest) {
+	int rows, cols, levels;
+
+	source.getImageInfo(rows, cols, levels);
+
+	const unsigned char* r = source.getPlane(0);
+	const unsigned char* g = source.getPlane(1);
+	const unsigned char* b = source.getPlane(2);
+
+	for(int i = 0; i < rows; i++) {
+		int* row = dest.getRow(i);
+		size_t base = (size_t)i * cols;
+		for(int j = 0; j < cols; j++) {
+			row[j*3] = r[base + j];
+			row[j*3+1] = g[base + j];
+			row[j*3+2] = b[base + j];
+		}
+	}
+}
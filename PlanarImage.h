@@ -0,0 +1,62 @@
+/* PlanarImage.h:
+ * 	Header containing the declarations for the PlanarImageType class,
+ * 	a companion to ImageType that stores each colour channel in its
+ * 	own contiguous 8-bit plane instead of interleaving r, g and b.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef PLANARIMAGE_H_
+#define PLANARIMAGE_H_
+
+#include <vector>
+
+#include "image.h"
+#include "rgb.h"
+
+class PlanarImageType {
+ public:
+   PlanarImageType();
+   PlanarImageType(int, int, int);
+   PlanarImageType(const PlanarImageType&);
+   ~PlanarImageType();
+   void getImageInfo(int&, int&, int&);
+   void setImageInfo(int, int, int);
+   void setPixelVal(int, int, RGB&);
+   void getPixelVal(int, int, RGB&);
+   unsigned char* getPlane(int);
+   PlanarImageType& operator=(const PlanarImageType&);
+ private:
+   int N, M, Q;                          // N: Rows; M: Columns; Q: Max. pixel value;
+   std::vector<unsigned char> planes[3]; // planes: Red, green and blue values, row by row.
+};
+
+
+/* toPlanar():
+ * 	Copies an interleaved RGB image into planar storage.
+ * args:
+ * 	@source: The image to copy.
+ * 	@dest: The image to store the copy in. Resized to match.
+ * return:
+ * 	void
+ */
+void toPlanar(ImageType& source, PlanarImageType& dest);
+
+
+/* toInterleaved():
+ * 	Copies a planar image into interleaved RGB storage.
+ * args:
+ * 	@source: The image to copy.
+ * 	@dest: The image to store the copy in. Must already be sized.
+ * return:
+ * 	void
+ */
+void toInterleaved(PlanarImageType& source, ImageType& dest);
+
+#include "PlanarImage.cpp"
+
+#endif
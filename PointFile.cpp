@@ -0,0 +1,267 @@
+/* PointFile.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for loading "x y label" data files into columns.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <fcntl.h>
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "PointFile.h"
+#include "Parallel.h"
+#include "MemoryStats.h"
+
+#define POINT_LINE_MAX   256          // Longest line read as a point.
+#define POINT_CHUNK_MIN  (1L << 16)   // Smallest byte range given to a thread.
+#define POINT_REPORT_MAX 10           // Malformed lines printed before summarizing.
+
+
+// Functions
+
+/* parsePointLine():
+ * 	Reads the three numbers of one line.
+ * args:
+ * 	@line: The start of the line.
+ * 	@length: The length of the line, without its newline.
+ * 	@x: Location to store the first feature.
+ * 	@y: Location to store the second feature.
+ * 	@id: Location to store the label.
+ * return:
+ * 	1: if a point was read.
+ * 	0: if the line is blank.
+ * 	-1: if the line is malformed.
+ */
+int parsePointLine(const char* line, size_t length, float& x, float& y, float& id) {
+	char buffer[POINT_LINE_MAX + 1];
+	char* end;
+	char* next;
+
+	if(length > POINT_LINE_MAX) {
+		return -1;
+	}
+
+	// Mapped lines are not terminated, so parse a terminated copy
+	memcpy(buffer, line, length);
+	buffer[length] = '\0';
+
+	next = buffer;
+	while(*next == ' ' || *next == '\t' || *next == '\r') {
+		next++;
+	}
+	if(*next == '\0') {
+		return 0;
+	}
+
+	x = strtof(next, &end);
+	if(end == next) {
+		return -1;
+	}
+	y = strtof(next = end, &end);
+	if(end == next) {
+		return -1;
+	}
+	id = strtof(next = end, &end);
+	if(end == next) {
+		return -1;
+	}
+
+	while(*end == ' ' || *end == '\t' || *end == '\r') {
+		end++;
+	}
+	return *end == '\0' ? 1 : -1;
+}
+
+
+/* parsePointRange():
+ * 	Reads every line in a byte range of a data file.
+ * args:
+ * 	@data: The start of the file.
+ * 	@begin: Offset of the first line in the range.
+ * 	@end: Offset just past the last line in the range.
+ * 	@points: Location to append the points to.
+ * return:
+ * 	void
+ */
+void parsePointRange(const char* data, size_t begin, size_t end, PointColumns& points) {
+	size_t start = begin;
+	float x, y, id;
+
+	while(start < end) {
+		const char* newline = (const char*)memchr(data + start, '\n', end - start);
+		size_t stop = newline == NULL ? end : (size_t)(newline - data);
+
+		int result = parsePointLine(data + start, stop - start, x, y, id);
+		if(result > 0) {
+			points.x.push_back(x);
+			points.y.push_back(y);
+			points.id.push_back(id);
+		}
+		else if(result < 0) {
+			points.malformed.push_back(start);
+		}
+
+		start = stop + 1;
+	}
+}
+
+
+/* pointColumnsBytes():
+ * 	Gets the memory held by a set of points.
+ * args:
+ * 	@points: The points.
+ * return:
+ * 	size_t: The size in bytes.
+ */
+size_t pointColumnsBytes(const PointColumns& points) {
+	return (points.x.capacity() + points.y.capacity() + points.id.capacity()) * sizeof(float)
+		+ points.malformed.capacity() * sizeof(size_t);
+}
+
+
+/* clearPointColumns():
+ * 	Releases a set of points.
+ * args:
+ * 	@points: The points.
+ * return:
+ * 	void
+ */
+void clearPointColumns(PointColumns& points) {
+	trackFree(MEMORY_DATASET, pointColumnsBytes(points));
+	std::vector<float>().swap(points.x);
+	std::vector<float>().swap(points.y);
+	std::vector<float>().swap(points.id);
+	std::vector<size_t>().swap(points.malformed);
+}
+
+
+/* ~PointColumns():
+ * 	Destructor for PointColumns.
+ */
+PointColumns::~PointColumns() {
+	clearPointColumns(*this);
+}
+
+
+/* loadPointColumns():
+ * 	Reads every point of a data file. Blank lines are ignored; any
+ * 	other line without three numbers is skipped and its offset kept
+ * 	in malformed.
+ * args:
+ * 	@fName: Path to the data file.
+ * 	@points: Location to store the points.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void loadPointColumns(const char* fName, PointColumns& points, int threads) {
+	struct stat info;
+	int fd = open(fName, O_RDONLY);
+
+	clearPointColumns(points);
+
+	if(fd < 0 || fstat(fd, &info) != 0) {
+		std::cout << "Error: Could not open file " << fName << std::endl;
+		exit(1);
+	}
+
+	size_t size = info.st_size;
+	if(size == 0) {
+		close(fd);
+		return;
+	}
+
+	const char* data = (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(data == (const char*)MAP_FAILED) {
+		std::cout << "Error: Could not map file " << fName << std::endl;
+		exit(1);
+	}
+	madvise((void*)data, size, MADV_SEQUENTIAL);
+
+	// Split into ranges, moving each split to just past a newline
+	if(threads < 1) {
+		threads = defaultThreadCount();
+	}
+	long ranges = (long)(size / POINT_CHUNK_MIN);
+	ranges = ranges < 1 ? 1 : (ranges > threads * 4L ? threads * 4L : ranges);
+
+	std::vector<size_t> bounds(ranges + 1);
+	bounds[0] = 0;
+	bounds[ranges] = size;
+	for(long k = 1; k < ranges; k++) {
+		size_t split = size * k / ranges;
+		if(split < bounds[k - 1]) {
+			split = bounds[k - 1];
+		}
+		const char* newline = (const char*)memchr(data + split, '\n', size - split);
+		bounds[k] = newline == NULL ? size : (size_t)(newline - data) + 1;
+	}
+
+	// Parse ranges on their own, then join in file order
+	std::vector<PointColumns> parts(ranges);
+	parallelFor((int)ranges, threads, [&](int begin, int end) {
+		for(int k = begin; k < end; k++) {
+			size_t guess = (bounds[k + 1] - bounds[k]) / 16;
+			parts[k].x.reserve(guess);
+			parts[k].y.reserve(guess);
+			parts[k].id.reserve(guess);
+			parsePointRange(data, bounds[k], bounds[k + 1], parts[k]);
+		}
+	});
+	munmap((void*)data, size);
+
+	size_t total = 0;
+	for(long k = 0; k < ranges; k++) {
+		total += parts[k].x.size();
+		trackAlloc(MEMORY_DATASET, pointColumnsBytes(parts[k]));
+	}
+	points.x.reserve(total);
+	points.y.reserve(total);
+	points.id.reserve(total);
+	for(long k = 0; k < ranges; k++) {
+		points.x.insert(points.x.end(), parts[k].x.begin(), parts[k].x.end());
+		points.y.insert(points.y.end(), parts[k].y.begin(), parts[k].y.end());
+		points.id.insert(points.id.end(), parts[k].id.begin(), parts[k].id.end());
+		points.malformed.insert(points.malformed.end(),
+			parts[k].malformed.begin(), parts[k].malformed.end());
+	}
+	trackAlloc(MEMORY_DATASET, pointColumnsBytes(points));
+	for(long k = 0; k < ranges; k++) {
+		clearPointColumns(parts[k]);
+	}
+}
+
+
+/* reportMalformedLines():
+ * 	Prints the offsets of lines that could not be read, if any.
+ * args:
+ * 	@fName: Path to the data file, for the message.
+ * 	@points: The points read from it.
+ * return:
+ * 	void
+ */
+void reportMalformedLines(const char* fName, const PointColumns& points) {
+	size_t count = points.malformed.size();
+
+	for(size_t k = 0; k < count && k < POINT_REPORT_MAX; k++) {
+		std::cout << "Warning: Skipped malformed line at byte "
+			<< points.malformed[k] << " of " << fName << std::endl;
+	}
+	if(count > POINT_REPORT_MAX) {
+		std::cout << "Warning: Skipped " << count - POINT_REPORT_MAX
+			<< " more malformed lines of " << fName << std::endl;
+	}
+}
@@ -0,0 +1,63 @@
+/* PointFile.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for loading "x y label" data files (e.g.
+ * 	ex1Data.txt) into columns.
+ *
+ * 	The file is mapped into memory and split into byte ranges that
+ * 	start and end on line boundaries; the ranges are parsed on
+ * 	separate threads and joined in file order.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef POINTFILE_H_
+#define POINTFILE_H_
+
+#include <stddef.h>
+#include <vector>
+
+/* PointColumns:
+ * 	The points of a data file, one entry per line in file order.
+ * 	Points read by loadPointColumns() count as dataset memory until
+ * 	they are destroyed.
+ */
+struct PointColumns {
+	std::vector<float> x;            // x: First feature of each point.
+	std::vector<float> y;            // y: Second feature of each point.
+	std::vector<float> id;           // id: Class label of each point.
+	std::vector<size_t> malformed;   // malformed: Byte offset of each line that could not be read.
+	~PointColumns();
+};
+
+
+/* loadPointColumns():
+ * 	Reads every point of a data file. Blank lines are ignored; any
+ * 	other line without three numbers is skipped and its offset kept
+ * 	in malformed.
+ * args:
+ * 	@fName: Path to the data file.
+ * 	@points: Location to store the points.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void loadPointColumns(const char* fName, PointColumns& points, int threads = 0);
+
+
+/* reportMalformedLines():
+ * 	Prints the offsets of lines that could not be read, if any.
+ * args:
+ * 	@fName: Path to the data file, for the message.
+ * 	@points: The points read from it.
+ * return:
+ * 	void
+ */
+void reportMalformedLines(const char* fName, const PointColumns& points);
+
+#include "PointFile.cpp"
+
+#endif
@@ -22,6 +22,8 @@ using namespace std;
 
 #include "image.h"
 #include "rgb.h"
+#include "PlanarImage.h"
+#include "MemoryStats.h"
 
 
 // Functions
@@ -70,6 +72,7 @@ ifp.getline(header,100,'\n');
  Q=strtol(header,&ptr,0);
 
  charImage = (unsigned char *) new unsigned char [M*N];
+ trackAlloc(MEMORY_IO, M*N);
 
  ifp.read( reinterpret_cast<char *>(charImage), (M*N)*sizeof(unsigned char));
 
@@ -92,27 +95,27 @@ ifp.getline(header,100,'\n');
      image.setPixelVal(i, j, val);     
    }
 
+ trackFree(MEMORY_IO, M*N);
  delete [] charImage;
 
 }
 
 
-/* readImagePPM():
- * 	Inputs the pixel values contained within a PPM image into
- * 	a given storage location.
+/* readHeaderPPM:
+ * 	Opens a PPM image and reads its header, leaving the stream at
+ * 	the first pixel value.
  * args:
- * 	@fname: Path to file to read pixel values from.
- * 	@image: The location to store the pixel values to.
+ * 	@fname: Path to file to read.
+ * 	@ifp: The stream to open.
+ * 	@N: Location to store the number of rows.
+ * 	@M: Location to store the number of columns.
+ * 	@Q: Location to store the max pixel value.
  * return:
  * 	void
  */
-void readImagePPM(char fname[], ImageType& image)
+void readHeaderPPM(char fname[], ifstream& ifp, int& N, int& M, int& Q)
 {
- int i, j;
- int N, M, Q;
- unsigned char *charImage;
  char header [100], *ptr;
- ifstream ifp;
 
  ifp.open(fname, ios::in | ios::binary);
   
@@ -140,8 +143,29 @@ void readImagePPM(char fname[], ImageType& image)
  
  ifp.getline(header,100,'\n');
  Q=strtol(header,&ptr,0);
+}
+
+
+/* readImagePPM():
+ * 	Inputs the pixel values contained within a PPM image into
+ * 	a given storage location.
+ * args:
+ * 	@fname: Path to file to read pixel values from.
+ * 	@image: The location to store the pixel values to.
+ * return:
+ * 	void
+ */
+void readImagePPM(char fname[], ImageType& image)
+{
+ int i, j;
+ int N, M, Q;
+ unsigned char *charImage;
+ ifstream ifp;
+
+ readHeaderPPM(fname, ifp, N, M, Q);
 
  charImage = (unsigned char *) new unsigned char [3*M*N];
+ trackAlloc(MEMORY_IO, 3*M*N);
 
  ifp.read( reinterpret_cast<char *>(charImage), (3*M*N)*sizeof(unsigned char));
 
@@ -164,6 +188,58 @@ void readImagePPM(char fname[], ImageType& image)
     image.setPixelVal(i, j/3, val);
   }
 
+trackFree(MEMORY_IO, 3*M*N);
 delete [] charImage;
 
 }
+
+
+/* readImagePPMPlanar():
+ * 	Inputs the pixel values contained within a PPM image into
+ * 	planar storage, splitting the channels as they are loaded.
+ * args:
+ * 	@fname: Path to file to read pixel values from.
+ * 	@image: The location to store the pixel values to. Resized
+ * 		to match the file.
+ * return:
+ * 	void
+ */
+void readImagePPMPlanar(char fname[], PlanarImageType& image)
+{
+ int N, M, Q;
+ unsigned char *charImage;
+ ifstream ifp;
+
+ readHeaderPPM(fname, ifp, N, M, Q);
+
+ image.setImageInfo(N, M, Q);
+
+ long count = (long)M*N;
+ charImage = (unsigned char *) new unsigned char [3*count];
+ trackAlloc(MEMORY_IO, 3*count);
+
+ ifp.read( reinterpret_cast<char *>(charImage), (3*count)*sizeof(unsigned char));
+
+ if (ifp.fail()) {
+   cout << "Image " << fname << " has wrong size" << endl;
+   exit(1);
+ }
+
+ ifp.close();
+
+ /* Split the channels straight into their planes */
+
+ unsigned char *r = image.getPlane(0);
+ unsigned char *g = image.getPlane(1);
+ unsigned char *b = image.getPlane(2);
+
+ for(long k=0; k < count; k++) {
+   r[k] = charImage[k*3];
+   g[k] = charImage[k*3+1];
+   b[k] = charImage[k*3+2];
+ }
+
+ trackFree(MEMORY_IO, 3*count);
+ delete [] charImage;
+
+}
@@ -2,6 +2,7 @@
 #define READIMAGE_H_
 
 #include "image.h"
+#include "PlanarImage.h"
 
 /* readImagePGM:
  * 	Inputs the pixel values contained within a PGM image into
@@ -26,6 +27,19 @@ void readImagePGM(char fname[], ImageType& image);
  */
 void readImagePPM(char fname[], ImageType& image);
 
+
+/* readImagePPMPlanar():
+ * 	Inputs the pixel values contained within a PPM image into
+ * 	planar storage, splitting the channels as they are loaded.
+ * args:
+ * 	@fname: Path to file to read pixel values from.
+ * 	@image: The location to store the pixel values to. Resized
+ * 		to match the file.
+ * return:
+ * 	void
+ */
+void readImagePPMPlanar(char fname[], PlanarImageType& image);
+
 #include "ReadImage.cpp"
 
 #endif
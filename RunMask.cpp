@@ -0,0 +1,421 @@
+/* RunMask.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for run-length skin masks.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <algorithm>
+#include <iostream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "image.h"
+#include "RunMask.h"
+#include "BitMask.h"
+#include "ColourSpace.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+#include "SkinModel.h"
+#include "SkinRegion.h"
+
+
+// Functions
+
+/* joinRowRuns():
+ * 	Gathers the runs found for each row into a mask.
+ * args:
+ * 	@rowRuns: The runs of each row.
+ * 	@cols: Columns of pixels.
+ * 	@mask: Location to store the runs.
+ * return:
+ * 	void
+ */
+void joinRowRuns(const std::vector<std::vector<MaskRun> >& rowRuns, int cols, RunMask& mask) {
+	mask.rows = rowRuns.size();
+	mask.cols = cols;
+	mask.rowFirst.assign(mask.rows + 1, 0);
+	for(int i = 0; i < mask.rows; i++) {
+		mask.rowFirst[i + 1] = mask.rowFirst[i] + rowRuns[i].size();
+	}
+
+	mask.runs.resize(mask.rowFirst[mask.rows]);
+	for(int i = 0; i < mask.rows; i++) {
+		std::copy(rowRuns[i].begin(), rowRuns[i].end(), mask.runs.begin() + mask.rowFirst[i]);
+	}
+}
+
+
+/* addRun():
+ * 	Ends a run at a column if one is open.
+ * args:
+ * 	@runs: The runs of the row.
+ * 	@start: First column of the open run, or -1 for none.
+ * 	@end: Column after the run.
+ * return:
+ * 	void
+ */
+inline void addRun(std::vector<MaskRun>& runs, int& start, int end) {
+	if(start >= 0) {
+		MaskRun run = { start, end };
+		runs.push_back(run);
+		start = -1;
+	}
+}
+
+
+/* runMaskForImage():
+ * 	Classifies an image straight into runs, without a full-size
+ * 	mask. Pixels are classified as by classifyForImage(). Rows are
+ * 	split across threads.
+ * args:
+ * 	@image: The image to classify.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForImage(ImageType& image, const SkinModel& model, RunMask& mask, int threads) {
+	int rows, cols, levels;
+	SkinPrefilter filter;
+
+	image.getImageInfo(rows, cols, levels);
+	prepareSkinPrefilter(model, filter);
+
+	std::vector<std::vector<MaskRun> > rowRuns(rows);
+	parallelFor(rows, threads, [&](int begin, int end) {
+		std::vector<float> x0(cols), x1(cols);
+
+		for(int i = begin; i < end; i++) {
+			const int* row = image.getRow(i);
+			int start = -1;
+
+			featuresForPixels(model.isRGB, row, cols, x0.data(), x1.data());
+			for(int j = 0; j < cols; j++) {
+				bool skin = passesSkinPrefilter(row[j*3], row[j*3+1], row[j*3+2], filter)
+					&& scoreForFeatures(x0[j], x1[j], model) > model.t;
+				if(skin && start < 0) {
+					start = j;
+				}
+				else if(!skin) {
+					addRun(rowRuns[i], start, j);
+				}
+			}
+			addRun(rowRuns[i], start, cols);
+		}
+	});
+
+	joinRowRuns(rowRuns, cols, mask);
+}
+
+
+/* runMaskForReference():
+ * 	Finds the runs of skin pixels (white or red) of a reference
+ * 	image, or of a classified image.
+ * args:
+ * 	@ref: The reference image.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForReference(ImageType& ref, RunMask& mask, int threads) {
+	int rows, cols, levels;
+
+	ref.getImageInfo(rows, cols, levels);
+	std::vector<std::vector<MaskRun> > rowRuns(rows);
+	parallelFor(rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			const int* row = ref.getRow(i);
+			int start = -1;
+
+			for(int j = 0; j < cols; j++) {
+				bool skin = isSkinLabel(row[j*3], row[j*3+1], row[j*3+2]);
+				if(skin && start < 0) {
+					start = j;
+				}
+				else if(!skin) {
+					addRun(rowRuns[i], start, j);
+				}
+			}
+			addRun(rowRuns[i], start, cols);
+		}
+	});
+
+	joinRowRuns(rowRuns, cols, mask);
+}
+
+
+/* runMaskForBits():
+ * 	Finds the runs of a packed mask.
+ * args:
+ * 	@bits: The packed mask.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForBits(const BitMask& bits, RunMask& mask, int threads) {
+	std::vector<std::vector<MaskRun> > rowRuns(bits.rows);
+
+	parallelFor(bits.rows, threads, [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			runsForRow(&bits.bits[(size_t)i * bits.words], bits.words, bits.cols, rowRuns[i]);
+		}
+	});
+
+	joinRowRuns(rowRuns, bits.cols, mask);
+}
+
+
+/* imageFromRunMask():
+ * 	Expands runs into an image (white=skin, black otherwise).
+ * args:
+ * 	@mask: The runs.
+ * 	@image: Location to output the pixels (same size as the mask).
+ * return:
+ * 	void
+ */
+void imageFromRunMask(const RunMask& mask, ImageType& image) {
+	RGB black, white;
+
+	black.r = black.g = black.b = 0;
+	white.r = white.g = white.b = 255;
+	for(int i = 0; i < mask.rows; i++) {
+		for(int j = 0; j < mask.cols; j++) {
+			image.setPixelVal(i, j, black);
+		}
+		for(long r = mask.rowFirst[i]; r < mask.rowFirst[i + 1]; r++) {
+			for(int j = mask.runs[r].start; j < mask.runs[r].end; j++) {
+				image.setPixelVal(i, j, white);
+			}
+		}
+	}
+}
+
+
+/* getMisclassRuns():
+ * 	Counts the pixels a mask gets wrong against a reference by
+ * 	merging the runs of each row. For a black and white reference
+ * 	this gives the counts of getMisclass().
+ * args:
+ * 	@mask: The classified runs.
+ * 	@ref: The reference runs (same size).
+ * 	@fp: Location to store the false positive count.
+ * 	@fn: Location to store the false negative count.
+ * return:
+ * 	void
+ */
+void getMisclassRuns(const RunMask& mask, const RunMask& ref, int& fp, int& fn) {
+	long maskCount = 0, refCount = 0, both = 0;
+
+	if(mask.rows != ref.rows || mask.cols != ref.cols) {
+		std::cout << "Error: Mask and reference differ in size" << std::endl;
+		exit(1);
+	}
+
+	for(int i = 0; i < mask.rows; i++) {
+		long a = mask.rowFirst[i], aEnd = mask.rowFirst[i + 1];
+		long b = ref.rowFirst[i], bEnd = ref.rowFirst[i + 1];
+
+		for(long r = a; r < aEnd; r++) {
+			maskCount += mask.runs[r].end - mask.runs[r].start;
+		}
+		for(long r = b; r < bEnd; r++) {
+			refCount += ref.runs[r].end - ref.runs[r].start;
+		}
+
+		// Overlap of the two sorted run lists
+		while(a < aEnd && b < bEnd) {
+			const MaskRun& x = mask.runs[a];
+			const MaskRun& y = ref.runs[b];
+			int lo = x.start > y.start ? x.start : y.start;
+			int hi = x.end < y.end ? x.end : y.end;
+			if(hi > lo) {
+				both += hi - lo;
+			}
+			if(x.end < y.end) {
+				a++;
+			}
+			else {
+				b++;
+			}
+		}
+	}
+
+	fp = maskCount - both;
+	fn = refCount - both;
+}
+
+
+/* putVarint():
+ * 	Appends a value as a LEB128 varint.
+ * args:
+ * 	@out: The bytes to add to.
+ * 	@val: The value.
+ * return:
+ * 	void
+ */
+void putVarint(std::vector<unsigned char>& out, uint32_t val) {
+	while(val >= 0x80) {
+		out.push_back((unsigned char)(val | 0x80));
+		val >>= 7;
+	}
+	out.push_back((unsigned char)val);
+}
+
+
+/* getVarint():
+ * 	Reads a LEB128 varint.
+ * args:
+ * 	@in: The bytes to read.
+ * 	@pos: Offset to read at; moved past the value.
+ * 	@val: Location to store the value.
+ * return:
+ * 	bool: true if a whole value was read.
+ */
+bool getVarint(const std::vector<unsigned char>& in, size_t& pos, uint32_t& val) {
+	val = 0;
+	for(int shift = 0; shift < 35 && pos < in.size(); shift += 7) {
+		unsigned char byte = in[pos++];
+		val |= (uint32_t)(byte & 0x7f) << shift;
+		if(!(byte & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/* loadRunMask():
+ * 	Reads a mask from a file written by saveRunMask().
+ * args:
+ * 	@fName: The path to the mask file.
+ * 	@mask: Location to store the runs.
+ * return:
+ * 	void
+ */
+void loadRunMask(char fName[], RunMask& mask) {
+	RunMaskHeader header;
+	std::vector<unsigned char> body;
+	FILE* inFile = fopen(fName, "rb");
+	bool valid;
+
+	if(inFile == NULL) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	valid = fread(&header, sizeof(header), 1, inFile) == 1
+		&& memcmp(header.magic, "SKNRLE01", 8) == 0
+		&& header.rows >= 0 && header.cols >= 0 && header.runs >= 0
+		&& header.runs <= (int64_t)header.rows * (((int64_t)header.cols + 1) / 2);
+	if(valid) {
+		unsigned char chunk[65536];
+		size_t got;
+		while((got = fread(chunk, 1, sizeof(chunk), inFile)) > 0) {
+			body.insert(body.end(), chunk, chunk + got);
+		}
+	}
+	fclose(inFile);
+
+	// Every row takes at least one byte and every run two, so the body
+	// bounds what the header may ask to allocate
+	valid = valid && (size_t)header.rows <= body.size();
+
+	// Check every run lies in its row, in order, without touching the last
+	size_t pos = 0;
+	if(valid) {
+		mask.rows = header.rows;
+		mask.cols = header.cols;
+		mask.rowFirst.assign((size_t)mask.rows + 1, 0);
+		mask.runs.clear();
+		mask.runs.reserve(std::min((size_t)header.runs, body.size() / 2));
+		for(int i = 0; i < mask.rows && valid; i++) {
+			uint32_t count, gap, length;
+			long end = -1;
+
+			valid = getVarint(body, pos, count) && count <= ((uint32_t)mask.cols + 1) / 2;
+			for(uint32_t r = 0; r < count && valid; r++) {
+				valid = getVarint(body, pos, gap) && getVarint(body, pos, length)
+					&& (r == 0 || gap > 0) && length > 0;
+				long start = (end < 0 ? 0 : end) + (long)gap;
+				valid = valid && start + (long)length <= mask.cols;
+				if(valid) {
+					MaskRun run = { (int)start, (int)(start + length) };
+					mask.runs.push_back(run);
+					end = run.end;
+				}
+			}
+			mask.rowFirst[i + 1] = mask.runs.size();
+		}
+		valid = valid && pos == body.size() && (int64_t)mask.runs.size() == header.runs;
+	}
+
+	if(!valid) {
+		std::cout << "Error: Invalid run mask "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+}
+
+
+/* saveRunMask():
+ * 	Writes a mask to a file.
+ * args:
+ * 	@fName: The path to the mask file.
+ * 	@mask: The runs to write.
+ * return:
+ * 	void
+ */
+void saveRunMask(char fName[], const RunMask& mask) {
+	RunMaskHeader header;
+	std::vector<unsigned char> body;
+	FILE* outFile = fopen(fName, "wb");
+
+	if(outFile == NULL) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "SKNRLE01", 8);
+	header.rows = mask.rows;
+	header.cols = mask.cols;
+	header.runs = mask.runs.size();
+
+	// Gaps are counted from the end of the last run in the row
+	for(int i = 0; i < mask.rows; i++) {
+		int end = 0;
+		putVarint(body, mask.rowFirst[i + 1] - mask.rowFirst[i]);
+		for(long r = mask.rowFirst[i]; r < mask.rowFirst[i + 1]; r++) {
+			putVarint(body, mask.runs[r].start - end);
+			putVarint(body, mask.runs[r].end - mask.runs[r].start);
+			end = mask.runs[r].end;
+		}
+	}
+
+	if(fwrite(&header, sizeof(header), 1, outFile) != 1
+		|| fwrite(body.data(), 1, body.size(), outFile) != body.size()
+		|| fclose(outFile) != 0) {
+		std::cout << "Error: Could not write "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+}
@@ -0,0 +1,138 @@
+/* RunMask.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for skin masks stored as runs of skin pixels
+ * 	in each row, and for comparing them without expanding them.
+ *
+ * 	A mask file holds a 24-byte header ("SKNRLE01", rows, cols and
+ * 	the run count) followed, for each row, by its number of runs and
+ * 	then the gap before and length of each run, all as LEB128
+ * 	varints. Mostly black masks take a few bytes per row.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef RUNMASK_H_
+#define RUNMASK_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "image.h"
+#include "BitMask.h"
+#include "SkinModel.h"
+
+/* RunMaskHeader:
+ * 	The fixed-size start of a run mask file.
+ */
+struct RunMaskHeader {
+	char magic[8];      // magic: "SKNRLE01".
+	int32_t rows;       // rows: Rows of pixels.
+	int32_t cols;       // cols: Columns of pixels.
+	int64_t runs;       // runs: Runs in the whole mask.
+};
+
+/* RunMask:
+ * 	The runs of skin pixels of every row, in column order.
+ */
+struct RunMask {
+	int rows;                      // rows: Rows of pixels.
+	int cols;                      // cols: Columns of pixels.
+	std::vector<long> rowFirst;    // rowFirst: Index of each row's first run; rows+1 entries.
+	std::vector<MaskRun> runs;     // runs: The runs, row after row.
+};
+
+
+/* runMaskForImage():
+ * 	Classifies an image straight into runs, without a full-size
+ * 	mask. Pixels are classified as by classifyForImage(). Rows are
+ * 	split across threads.
+ * args:
+ * 	@image: The image to classify.
+ * 	@model: The model and threshold to classify with.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForImage(ImageType& image, const SkinModel& model, RunMask& mask, int threads = 0);
+
+
+/* runMaskForReference():
+ * 	Finds the runs of skin pixels (white or red) of a reference
+ * 	image, or of a classified image.
+ * args:
+ * 	@ref: The reference image.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForReference(ImageType& ref, RunMask& mask, int threads = 0);
+
+
+/* runMaskForBits():
+ * 	Finds the runs of a packed mask.
+ * args:
+ * 	@bits: The packed mask.
+ * 	@mask: Location to store the runs.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void runMaskForBits(const BitMask& bits, RunMask& mask, int threads = 0);
+
+
+/* imageFromRunMask():
+ * 	Expands runs into an image (white=skin, black otherwise).
+ * args:
+ * 	@mask: The runs.
+ * 	@image: Location to output the pixels (same size as the mask).
+ * return:
+ * 	void
+ */
+void imageFromRunMask(const RunMask& mask, ImageType& image);
+
+
+/* getMisclassRuns():
+ * 	Counts the pixels a mask gets wrong against a reference by
+ * 	merging the runs of each row. For a black and white reference
+ * 	this gives the counts of getMisclass().
+ * args:
+ * 	@mask: The classified runs.
+ * 	@ref: The reference runs (same size).
+ * 	@fp: Location to store the false positive count.
+ * 	@fn: Location to store the false negative count.
+ * return:
+ * 	void
+ */
+void getMisclassRuns(const RunMask& mask, const RunMask& ref, int& fp, int& fn);
+
+
+/* loadRunMask():
+ * 	Reads a mask from a file written by saveRunMask().
+ * args:
+ * 	@fName: The path to the mask file.
+ * 	@mask: Location to store the runs.
+ * return:
+ * 	void
+ */
+void loadRunMask(char fName[], RunMask& mask);
+
+
+/* saveRunMask():
+ * 	Writes a mask to a file.
+ * args:
+ * 	@fName: The path to the mask file.
+ * 	@mask: The runs to write.
+ * return:
+ * 	void
+ */
+void saveRunMask(char fName[], const RunMask& mask);
+
+#include "RunMask.cpp"
+
+#endif
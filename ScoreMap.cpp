@@ -0,0 +1,332 @@
+/* ScoreMap.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for storing and thresholding per-pixel scores.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <fcntl.h>
+#include <iostream>
+#include <math.h>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "image.h"
+#include "ScoreMap.h"
+#include "ColourSpace.h"
+#include "MemoryStats.h"
+#include "ModelStats.h"
+#include "Parallel.h"
+#include "SkinModel.h"
+
+
+// Functions
+
+/* defaultScoreRange():
+ * 	Picks a score range for a model: from 64 below its highest
+ * 	possible score up to just above that score. Scores below the
+ * 	range are stored as its low end, so a map can only answer
+ * 	thresholds inside the range; pass a lower -lo to score for
+ * 	looser thresholds.
+ * args:
+ * 	@model: The model.
+ * 	@lo: Location to store the low end of the range.
+ * 	@hi: Location to store the high end of the range.
+ * return:
+ * 	void
+ */
+void defaultScoreRange(const SkinModel& model, float& lo, float& hi) {
+	// The score is a concave quadratic peaking at the mean
+	float peak = scoreForFeatures(model.mu[0], model.mu[1], model);
+
+	hi = peak + 1e-3f * (1 + fabsf(peak));
+	lo = hi - 64;
+}
+
+
+/* releaseScoreCodes():
+ * 	Frees the codes a score map computed in memory.
+ * args:
+ * 	@map: The score map.
+ * return:
+ * 	void
+ */
+void releaseScoreCodes(ScoreMap& map) {
+	trackFree(MEMORY_IMAGE, map.owned.size() * sizeof(uint16_t));
+	std::vector<uint16_t>().swap(map.owned);
+}
+
+
+/* scoreMapForImage():
+ * 	Scores every pixel of an image. Rows are split across threads.
+ * args:
+ * 	@image: The image to score.
+ * 	@model: The model to score with.
+ * 	@lo: The low end of the score range.
+ * 	@hi: The high end of the score range.
+ * 	@map: Location to store the score map.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void scoreMapForImage(ImageType& image, const SkinModel& model, float lo, float hi,
+	ScoreMap& map, int threads) {
+	int rows, cols, levels;
+	double scale = (SCORE_CODES - 1) / ((double)hi - lo);
+
+	if(!(hi > lo)) {
+		std::cout << "Error: Score range is empty" << std::endl;
+		exit(1);
+	}
+
+	image.getImageInfo(rows, cols, levels);
+	memset(&map.header, 0, sizeof(map.header));
+	memcpy(map.header.magic, "SKNSCOR1", 8);
+	map.header.rows = rows;
+	map.header.cols = cols;
+	map.header.lo = lo;
+	map.header.hi = hi;
+	map.header.isRGB = model.isRGB;
+	releaseScoreCodes(map);
+	map.owned.resize((size_t)rows * cols);
+	trackAlloc(MEMORY_IMAGE, map.owned.size() * sizeof(uint16_t));
+	map.codes = map.owned.data();
+	map.mapping = NULL;
+	map.mapLength = 0;
+
+	parallelFor(rows, threads, [&](int begin, int end) {
+		std::vector<float> x0(cols), x1(cols);
+
+		for(int i = begin; i < end; i++) {
+			uint16_t* codes = &map.owned[(size_t)i * cols];
+			featuresForPixels(model.isRGB, image.getRow(i), cols, x0.data(), x1.data());
+
+			for(int j = 0; j < cols; j++) {
+				double code = floor((scoreForFeatures(x0[j], x1[j], model) - (double)lo) * scale);
+				codes[j] = code <= 0 ? 0 : (code >= SCORE_CODES - 1 ? SCORE_CODES - 1 : (uint16_t)code);
+			}
+		}
+	});
+}
+
+
+/* saveScoreMap():
+ * 	Writes a score map to a file.
+ * args:
+ * 	@fName: The path to the score map file.
+ * 	@map: The score map to write.
+ * return:
+ * 	void
+ */
+void saveScoreMap(char fName[], const ScoreMap& map) {
+	size_t count = (size_t)map.header.rows * map.header.cols;
+	FILE* outFile = fopen(fName, "wb");
+
+	if(outFile == NULL) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	if(fwrite(&map.header, sizeof(map.header), 1, outFile) != 1
+		|| fwrite(map.codes, sizeof(uint16_t), count, outFile) != count
+		|| fclose(outFile) != 0) {
+		std::cout << "Error: Could not write "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+}
+
+
+/* openScoreMap():
+ * 	Maps a score map file into memory. Nothing is copied.
+ * args:
+ * 	@fName: The path to the score map file.
+ * 	@map: Location to store the score map.
+ * return:
+ * 	void
+ */
+void openScoreMap(char fName[], ScoreMap& map) {
+	struct stat info;
+	int fd = open(fName, O_RDONLY);
+
+	if(fd < 0 || fstat(fd, &info) != 0) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	map.mapLength = info.st_size;
+	map.mapping = map.mapLength < sizeof(ScoreMapHeader) ? MAP_FAILED
+		: mmap(NULL, map.mapLength, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	// Check the header before trusting the size it gives
+	if(map.mapping == MAP_FAILED) {
+		std::cout << "Error: Invalid score map "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+	memcpy(&map.header, map.mapping, sizeof(map.header));
+	if(memcmp(map.header.magic, "SKNSCOR1", 8) != 0 || map.mapLength != sizeof(ScoreMapHeader)
+		+ (size_t)map.header.rows * map.header.cols * sizeof(uint16_t)) {
+		std::cout << "Error: Invalid score map "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	map.codes = (const uint16_t*)((const char*)map.mapping + sizeof(ScoreMapHeader));
+	releaseScoreCodes(map);
+}
+
+
+/* closeScoreMap():
+ * 	Releases a score map opened with openScoreMap() or computed
+ * 	with scoreMapForImage().
+ * args:
+ * 	@map: The score map.
+ * return:
+ * 	void
+ */
+void closeScoreMap(ScoreMap& map) {
+	if(map.mapping != NULL) {
+		munmap(map.mapping, map.mapLength);
+	}
+	map.mapping = NULL;
+	map.mapLength = 0;
+	map.codes = NULL;
+	releaseScoreCodes(map);
+}
+
+
+/* thresholdCode():
+ * 	Gets the highest code that a threshold rejects.
+ * args:
+ * 	@header: The header of the score map.
+ * 	@t: The threshold, in [lo, hi) of the header. Scores outside
+ * 		that range were clamped, so other thresholds are wrong.
+ * return:
+ * 	long: Pixels with codes above this are skin (-1 if all are).
+ */
+long thresholdCode(const ScoreMapHeader& header, float t) {
+	double code = floor(((double)t - header.lo) * (SCORE_CODES - 1) / ((double)header.hi - header.lo));
+
+	if(code < 0) {
+		return -1;
+	}
+	return code >= SCORE_CODES - 1 ? SCORE_CODES - 1 : (long)code;
+}
+
+
+/* thresholdScoreMap():
+ * 	Classifies every pixel of a score map at a threshold.
+ * args:
+ * 	@map: The score map.
+ * 	@t: The threshold.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void thresholdScoreMap(const ScoreMap& map, float t, unsigned char* mask) {
+	size_t count = (size_t)map.header.rows * map.header.cols;
+	long limit = thresholdCode(map.header, t);
+
+	for(size_t k = 0; k < count; k++) {
+		mask[k] = map.codes[k] > limit ? 255 : 0;
+	}
+}
+
+
+/* histogramForScoreMap():
+ * 	Counts the pixels at each code, split by a reference image, so
+ * 	misclassifications can be read off for any threshold.
+ * args:
+ * 	@map: The score map.
+ * 	@ref: The reference image (white or red=skin).
+ * 	@hist: Location to store the counts.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void histogramForScoreMap(const ScoreMap& map, ImageType& ref, ScoreHistogram& hist, int threads) {
+	int rows, cols, levels;
+	std::mutex lock;
+
+	ref.getImageInfo(rows, cols, levels);
+	if((uint32_t)rows != map.header.rows || (uint32_t)cols != map.header.cols) {
+		std::cout << "Error: Reference image and score map differ in size" << std::endl;
+		exit(1);
+	}
+
+	hist.skin.assign(SCORE_CODES, 0);
+	hist.other.assign(SCORE_CODES, 0);
+
+	// Count each band on its own, then add the counts together
+	parallelFor(rows, threads, [&](int begin, int end) {
+		std::vector<long> skin(SCORE_CODES, 0), other(SCORE_CODES, 0);
+
+		for(int i = begin; i < end; i++) {
+			const int* refRow = ref.getRow(i);
+			const uint16_t* codes = map.codes + (size_t)i * cols;
+			for(int j = 0; j < cols; j++) {
+				if(isSkinLabel(refRow[j*3], refRow[j*3+1], refRow[j*3+2])) {
+					skin[codes[j]]++;
+				}
+				else {
+					other[codes[j]]++;
+				}
+			}
+		}
+
+		std::lock_guard<std::mutex> hold(lock);
+		for(int k = 0; k < SCORE_CODES; k++) {
+			hist.skin[k] += skin[k];
+			hist.other[k] += other[k];
+		}
+	});
+}
+
+
+/* misclassForHistogram():
+ * 	Gets the number of pixels misclassified at a threshold.
+ * args:
+ * 	@hist: The counts from histogramForScoreMap().
+ * 	@header: The header of the score map.
+ * 	@t: The threshold.
+ * 	@fp: The number of false positives.
+ * 	@fn: The number of false negatives.
+ * return:
+ * 	void
+ */
+void misclassForHistogram(const ScoreHistogram& hist, const ScoreMapHeader& header,
+	float t, long& fp, long& fn) {
+	long limit = thresholdCode(header, t);
+
+	fp = 0;
+	fn = 0;
+	for(long k = 0; k < SCORE_CODES; k++) {
+		if(k > limit) {
+			fp += hist.other[k];
+		}
+		else {
+			fn += hist.skin[k];
+		}
+	}
+}
@@ -0,0 +1,186 @@
+/* ScoreMap.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for storing the discriminant of every pixel of
+ * 	an image, so it can be thresholded again for any t without
+ * 	classifying the image again.
+ *
+ * 	A score map file is a ScoreMapHeader followed by one uint16 code
+ * 	per pixel, row by row, in host byte order. Scores in [lo, hi) are
+ * 	spread evenly over the codes; scores outside are clamped. A
+ * 	threshold inside [lo, hi) decides every pixel the same way as
+ * 	the model, except pixels whose score is within one code step,
+ * 	(hi - lo) / 65535, of the threshold.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef SCOREMAP_H_
+#define SCOREMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "image.h"
+#include "SkinModel.h"
+
+#define SCORE_CODES 65536     // Number of distinct quantized scores.
+
+/* ScoreMapHeader:
+ * 	The fixed-size header leading a score map file.
+ */
+struct ScoreMapHeader {
+	char magic[8];       // magic: Always "SKNSCOR1".
+	uint32_t rows;       // rows: Number of pixel rows.
+	uint32_t cols;       // cols: Number of pixel columns.
+	float lo;            // lo: Score of code 0.
+	float hi;            // hi: Score of code 65535.
+	uint32_t isRGB;      // isRGB: Colour scheme of the model (1=RGB, 0=YCrCb).
+	uint32_t reserved;   // reserved: Always 0.
+};
+
+/* ScoreMap:
+ * 	The codes of an image, either computed in memory or mapped
+ * 	from a file.
+ */
+struct ScoreMap {
+	ScoreMapHeader header;          // header: Size and score range.
+	const uint16_t* codes;          // codes: One code per pixel, row by row.
+	std::vector<uint16_t> owned;    // owned: Storage for computed codes.
+	void* mapping;                  // mapping: The mapped file, or NULL.
+	size_t mapLength;               // mapLength: Length of the mapping.
+};
+
+/* ScoreHistogram:
+ * 	Number of pixels at each code, split by their reference label.
+ */
+struct ScoreHistogram {
+	std::vector<long> skin;         // skin: Skin pixels at each code.
+	std::vector<long> other;        // other: Every other pixel at each code.
+};
+
+
+/* defaultScoreRange():
+ * 	Picks a score range for a model: from 64 below its highest
+ * 	possible score up to just above that score. Scores below the
+ * 	range are stored as its low end, so a map can only answer
+ * 	thresholds inside the range; pass a lower -lo to score for
+ * 	looser thresholds.
+ * args:
+ * 	@model: The model.
+ * 	@lo: Location to store the low end of the range.
+ * 	@hi: Location to store the high end of the range.
+ * return:
+ * 	void
+ */
+void defaultScoreRange(const SkinModel& model, float& lo, float& hi);
+
+
+/* scoreMapForImage():
+ * 	Scores every pixel of an image. Rows are split across threads.
+ * args:
+ * 	@image: The image to score.
+ * 	@model: The model to score with.
+ * 	@lo: The low end of the score range.
+ * 	@hi: The high end of the score range.
+ * 	@map: Location to store the score map.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void scoreMapForImage(ImageType& image, const SkinModel& model, float lo, float hi,
+	ScoreMap& map, int threads = 0);
+
+
+/* saveScoreMap():
+ * 	Writes a score map to a file.
+ * args:
+ * 	@fName: The path to the score map file.
+ * 	@map: The score map to write.
+ * return:
+ * 	void
+ */
+void saveScoreMap(char fName[], const ScoreMap& map);
+
+
+/* openScoreMap():
+ * 	Maps a score map file into memory. Nothing is copied.
+ * args:
+ * 	@fName: The path to the score map file.
+ * 	@map: Location to store the score map.
+ * return:
+ * 	void
+ */
+void openScoreMap(char fName[], ScoreMap& map);
+
+
+/* closeScoreMap():
+ * 	Releases a score map opened with openScoreMap() or computed
+ * 	with scoreMapForImage().
+ * args:
+ * 	@map: The score map.
+ * return:
+ * 	void
+ */
+void closeScoreMap(ScoreMap& map);
+
+
+/* thresholdCode():
+ * 	Gets the highest code that a threshold rejects.
+ * args:
+ * 	@header: The header of the score map.
+ * 	@t: The threshold, in [lo, hi) of the header. Scores outside
+ * 		that range were clamped, so other thresholds are wrong.
+ * return:
+ * 	long: Pixels with codes above this are skin (-1 if all are).
+ */
+long thresholdCode(const ScoreMapHeader& header, float t);
+
+
+/* thresholdScoreMap():
+ * 	Classifies every pixel of a score map at a threshold.
+ * args:
+ * 	@map: The score map.
+ * 	@t: The threshold.
+ * 	@mask: Location to output one value per pixel (255=skin, 0=not).
+ * return:
+ * 	void
+ */
+void thresholdScoreMap(const ScoreMap& map, float t, unsigned char* mask);
+
+
+/* histogramForScoreMap():
+ * 	Counts the pixels at each code, split by a reference image, so
+ * 	misclassifications can be read off for any threshold.
+ * args:
+ * 	@map: The score map.
+ * 	@ref: The reference image (white or red=skin).
+ * 	@hist: Location to store the counts.
+ * 	@threads: The number of threads to use (<1 for default).
+ * return:
+ * 	void
+ */
+void histogramForScoreMap(const ScoreMap& map, ImageType& ref, ScoreHistogram& hist, int threads = 0);
+
+
+/* misclassForHistogram():
+ * 	Gets the number of pixels misclassified at a threshold.
+ * args:
+ * 	@hist: The counts from histogramForScoreMap().
+ * 	@header: The header of the score map.
+ * 	@t: The threshold.
+ * 	@fp: The number of false positives.
+ * 	@fn: The number of false negatives.
+ * return:
+ * 	void
+ */
+void misclassForHistogram(const ScoreHistogram& hist, const ScoreMapHeader& header,
+	float t, long& fp, long& fn);
+
+#include "ScoreMap.cpp"
+
+#endif
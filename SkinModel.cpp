@@ -0,0 +1,359 @@
+/* SkinModel.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for storing, loading and scoring with a trained
+ * 	skin model.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdlib.h>
+#include <string>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Eigen/Dense"
+#include "rgb.h"
+#include "SkinModel.h"
+#include "ColourSpace.h"
+#include "ExperimentModels.h"
+
+
+// Functions
+
+/* defaultSkinModel():
+ * 	Gets the model trained for the project experiments.
+ * args:
+ * 	@isRGB: The colour scheme of the model (1=RGB, 0=YCrCb).
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void defaultSkinModel(bool isRGB, SkinModel& model) {
+	if(isRGB) {
+		skinModelFromStatic<RGBSkinModel>(model);
+	}
+	else {
+		skinModelFromStatic<YCCSkinModel>(model);
+	}
+}
+
+
+/* prepareSkinModel():
+ * 	Calculates the values of a model derived from its mean and
+ * 	covariance matrix. Must be called after either changes.
+ * args:
+ * 	@model: The model to prepare.
+ * return:
+ * 	void
+ */
+void prepareSkinModel(SkinModel& model) {
+	Eigen::Vector2f mu;
+	Eigen::Matrix2f covm;
+
+	mu << model.mu[0], model.mu[1];
+	covm << model.cov[0][0], model.cov[0][1],
+	     model.cov[1][0], model.cov[1][1];
+
+	Eigen::Matrix2f inv = covm.inverse();
+	Eigen::Vector2f invMu = inv * mu;
+
+	for(int i = 0; i < 2; i++) {
+		model.invMu[i] = invMu(i);
+		for(int j = 0; j < 2; j++) {
+			model.inv[i][j] = inv(i, j);
+		}
+	}
+	model.bias = (-0.5 * mu.transpose() * inv * mu) + (-0.5 * log(covm.determinant()));
+}
+
+
+/* loadSkinModel():
+ * 	Reads a model from a file written by saveSkinModel().
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void loadSkinModel(char fName[], SkinModel& model) {
+	// Variables
+	std::ifstream inFile(fName);
+	std::string key;
+	int found = 0;
+
+	// Test if file not properly opened
+	if(!inFile.is_open()) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	// Read each keyed line
+	while(inFile >> key) {
+		if(key[0] == '#') {
+			std::getline(inFile, key);
+		}
+		else if(key == "space") {
+			inFile >> key;
+			model.isRGB = (key == "rgb");
+			found |= 1;
+		}
+		else if(key == "prior") {
+			inFile >> model.prior;
+			found |= 2;
+		}
+		else if(key == "mean") {
+			inFile >> model.mu[0] >> model.mu[1];
+			found |= 4;
+		}
+		else if(key == "cov") {
+			inFile >> model.cov[0][0] >> model.cov[0][1]
+				>> model.cov[1][0] >> model.cov[1][1];
+			found |= 8;
+		}
+		else if(key == "threshold") {
+			inFile >> model.t;
+			found |= 16;
+		}
+		else {
+			break;
+		}
+	}
+
+	// Test for missing or unreadable values
+	if(found != 31 || (inFile.fail() && !inFile.eof())) {
+		std::cout << "Error: Invalid model file "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	prepareSkinModel(model);
+}
+
+
+/* saveSkinModel():
+ * 	Writes a model to a file.
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: The model to write.
+ * return:
+ * 	void
+ */
+void saveSkinModel(char fName[], const SkinModel& model) {
+	std::ofstream outFile(fName);
+
+	if(!outFile.is_open()) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	outFile << std::setprecision(9);
+	outFile << "# Skin model" << std::endl;
+	outFile << "space " << (model.isRGB ? "rgb" : "ycc") << std::endl;
+	outFile << "prior " << model.prior << std::endl;
+	outFile << "mean " << model.mu[0] << " " << model.mu[1] << std::endl;
+	outFile << "cov " << model.cov[0][0] << " " << model.cov[0][1] << " "
+		<< model.cov[1][0] << " " << model.cov[1][1] << std::endl;
+	outFile << "threshold " << model.t << std::endl;
+
+	outFile.close();
+}
+
+
+/* scoreForFeatures():
+ * 	Calculates the discriminant of a pair of colour features under
+ * 	a model.
+ * args:
+ * 	@x0: The first feature.
+ * 	@x1: The second feature.
+ * 	@model: The model to score with.
+ * return:
+ * 	float: The discriminant value. Skin if greater than model.t.
+ */
+inline float scoreForFeatures(float x0, float x1, const SkinModel& model) {
+	float quad = model.inv[0][0] * x0 * x0
+		+ (model.inv[0][1] + model.inv[1][0]) * x0 * x1
+		+ model.inv[1][1] * x1 * x1;
+
+	return -0.5f * quad + model.invMu[0] * x0 + model.invMu[1] * x1 + model.bias;
+}
+
+
+/* scoreForPixel():
+ * 	Calculates the discriminant of a pixel value under a model.
+ * args:
+ * 	@pix: The pixel to score.
+ * 	@model: The model to score with.
+ * return:
+ * 	float: The discriminant value. Skin if greater than model.t.
+ */
+float scoreForPixel(RGB& pix, const SkinModel& model) {
+	float x0, x1;
+	featuresForPixel(model.isRGB, pix.r, pix.g, pix.b, x0, x1);
+	return scoreForFeatures(x0, x1, model);
+}
+
+
+/* formatConstant():
+ * 	Formats a value as a float literal that reads back exactly.
+ * args:
+ * 	@text: Location to store the literal (at least 32 bytes).
+ * 	@val: The value to format.
+ * return:
+ * 	void
+ */
+void formatConstant(char text[], float val) {
+	snprintf(text, 28, "%.9g", val);
+	if(strpbrk(text, ".e") == NULL) {
+		strcat(text, ".0");
+	}
+	strcat(text, "f");
+}
+
+
+/* exportSkinModelHeader():
+ * 	Writes a C++ header that holds models as compile-time constants,
+ * 	including their derived values, for use with the
+ * 	scoreForPixelStatic() and classifyForPixelStatic() templates.
+ * args:
+ * 	@fName: The path to the header to write.
+ * 	@models: The models to write.
+ * 	@names: The struct name to give each model.
+ * 	@count: The number of models.
+ * return:
+ * 	void
+ */
+void exportSkinModelHeader(char fName[], const SkinModel models[], char* names[], int count) {
+	std::ofstream outFile(fName);
+	std::string base = fName;
+	std::string guard;
+	char text[32];
+
+	if(!outFile.is_open()) {
+		std::cout << "Error: Could not open "
+			<< fName
+			<< std::endl;
+		exit(1);
+	}
+
+	// Build include guard from file name
+	base = base.substr(base.find_last_of('/') + 1);
+	guard = base;
+	for(size_t k = 0; k < guard.size(); k++) {
+		guard[k] = isalnum(guard[k]) ? toupper(guard[k]) : '_';
+	}
+	guard += "_";
+
+	outFile << "/* " << base << ":" << std::endl;
+	outFile << " * \tSkin models as compile-time constants." << std::endl;
+	outFile << " * \tGenerated by `main export-header`; do not edit." << std::endl;
+	outFile << " */" << std::endl << std::endl;
+	outFile << "#ifndef " << guard << std::endl;
+	outFile << "#define " << guard << std::endl;
+
+	for(int k = 0; k < count; k++) {
+		const SkinModel& model = models[k];
+		double logDet = log((double)model.cov[0][0] * model.cov[1][1]
+			- (double)model.cov[0][1] * model.cov[1][0]);
+		const char* keys[] = { "prior", "mu0", "mu1", "cov00", "cov01",
+			"cov10", "cov11", "t", "inv00", "inv01", "inv10", "inv11",
+			"invMu0", "invMu1", "bias", "logDet" };
+		float vals[] = { model.prior, model.mu[0], model.mu[1],
+			model.cov[0][0], model.cov[0][1], model.cov[1][0],
+			model.cov[1][1], model.t, model.inv[0][0], model.inv[0][1],
+			model.inv[1][0], model.inv[1][1], model.invMu[0],
+			model.invMu[1], model.bias, (float)logDet };
+
+		outFile << std::endl << "struct " << names[k] << " {" << std::endl;
+		outFile << "\tstatic constexpr bool isRGB = "
+			<< (model.isRGB ? "true" : "false") << ";" << std::endl;
+		for(int v = 0; v < 16; v++) {
+			formatConstant(text, vals[v]);
+			outFile << "\tstatic constexpr float " << keys[v] << " = "
+				<< text << ";" << std::endl;
+		}
+		outFile << "};" << std::endl;
+	}
+
+	outFile << std::endl << "#endif" << std::endl;
+	outFile.close();
+}
+
+
+/* skinModelFromStatic():
+ * 	Copies a compile-time model into a SkinModel.
+ * args:
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+template<class Model>
+void skinModelFromStatic(SkinModel& model) {
+	model.isRGB = Model::isRGB;
+	model.prior = Model::prior;
+	model.mu[0] = Model::mu0;
+	model.mu[1] = Model::mu1;
+	model.cov[0][0] = Model::cov00;
+	model.cov[0][1] = Model::cov01;
+	model.cov[1][0] = Model::cov10;
+	model.cov[1][1] = Model::cov11;
+	model.t = Model::t;
+	model.inv[0][0] = Model::inv00;
+	model.inv[0][1] = Model::inv01;
+	model.inv[1][0] = Model::inv10;
+	model.inv[1][1] = Model::inv11;
+	model.invMu[0] = Model::invMu0;
+	model.invMu[1] = Model::invMu1;
+	model.bias = Model::bias;
+}
+
+
+/* scoreForPixelStatic():
+ * 	Calculates the discriminant of a pixel value under a compile-time
+ * 	model, so every model value is folded into the code.
+ * args:
+ * 	@pix: The pixel to score.
+ * return:
+ * 	float: The discriminant value. Skin if greater than Model::t.
+ */
+template<class Model>
+float scoreForPixelStatic(RGB& pix) {
+	// Calculate pixel feature values
+	float x0, x1;
+	featuresForPixel(Model::isRGB, pix.r, pix.g, pix.b, x0, x1);
+
+	// Calculate discriminant
+	float quad = Model::inv00 * x0 * x0
+		+ (Model::inv01 + Model::inv10) * x0 * x1
+		+ Model::inv11 * x1 * x1;
+
+	return -0.5f * quad + Model::invMu0 * x0 + Model::invMu1 * x1 + Model::bias;
+}
+
+
+/* classifyForPixelStatic():
+ * 	Classifies a pixel value under a compile-time model.
+ * args:
+ * 	@pix: The pixel to classify.
+ * return:
+ * 	true: if the pixel is classified as skin.
+ * 	false: otherwise.
+ */
+template<class Model>
+bool classifyForPixelStatic(RGB& pix) {
+	return scoreForPixelStatic<Model>(pix) > Model::t;
+}
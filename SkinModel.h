@@ -0,0 +1,152 @@
+/* SkinModel.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for storing, loading and scoring with a trained
+ * 	skin model.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef SKINMODEL_H_
+#define SKINMODEL_H_
+
+#include "rgb.h"
+
+/* SkinModel:
+ * 	A Gaussian model of skin pixels in a 2D colour feature space,
+ * 	along with the threshold used to classify with it.
+ */
+struct SkinModel {
+	bool isRGB;          // isRGB: Colour scheme (1=RGB, 0=YCrCb).
+	float prior;         // prior: Prior probability of skin.
+	float mu[2];         // mu: Sample mean of the features.
+	float cov[2][2];     // cov: Sample covariance matrix.
+	float t;             // t: Threshold for classifying skin.
+	float inv[2][2];     // inv: Inverse of the covariance matrix.
+	float invMu[2];      // invMu: inv * mu.
+	float bias;          // bias: -0.5 * mu^T * inv * mu - 0.5 * log|cov|.
+};
+
+
+/* defaultSkinModel():
+ * 	Gets the model trained for the project experiments.
+ * args:
+ * 	@isRGB: The colour scheme of the model (1=RGB, 0=YCrCb).
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void defaultSkinModel(bool isRGB, SkinModel& model);
+
+
+/* prepareSkinModel():
+ * 	Calculates the values of a model derived from its mean and
+ * 	covariance matrix. Must be called after either changes.
+ * args:
+ * 	@model: The model to prepare.
+ * return:
+ * 	void
+ */
+void prepareSkinModel(SkinModel& model);
+
+
+/* loadSkinModel():
+ * 	Reads a model from a file written by saveSkinModel().
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+void loadSkinModel(char fName[], SkinModel& model);
+
+
+/* saveSkinModel():
+ * 	Writes a model to a file.
+ * args:
+ * 	@fName: The path to the model file.
+ * 	@model: The model to write.
+ * return:
+ * 	void
+ */
+void saveSkinModel(char fName[], const SkinModel& model);
+
+
+/* scoreForFeatures():
+ * 	Calculates the discriminant of a pair of colour features under
+ * 	a model.
+ * args:
+ * 	@x0: The first feature.
+ * 	@x1: The second feature.
+ * 	@model: The model to score with.
+ * return:
+ * 	float: The discriminant value. Skin if greater than model.t.
+ */
+inline float scoreForFeatures(float x0, float x1, const SkinModel& model);
+
+
+/* scoreForPixel():
+ * 	Calculates the discriminant of a pixel value under a model.
+ * args:
+ * 	@pix: The pixel to score.
+ * 	@model: The model to score with.
+ * return:
+ * 	float: The discriminant value. Skin if greater than model.t.
+ */
+float scoreForPixel(RGB& pix, const SkinModel& model);
+
+/* exportSkinModelHeader():
+ * 	Writes a C++ header that holds models as compile-time constants,
+ * 	including their derived values, for use with the
+ * 	scoreForPixelStatic() and classifyForPixelStatic() templates.
+ * args:
+ * 	@fName: The path to the header to write.
+ * 	@models: The models to write.
+ * 	@names: The struct name to give each model.
+ * 	@count: The number of models.
+ * return:
+ * 	void
+ */
+void exportSkinModelHeader(char fName[], const SkinModel models[], char* names[], int count);
+
+
+/* skinModelFromStatic():
+ * 	Copies a compile-time model into a SkinModel.
+ * args:
+ * 	@model: Location to store the model.
+ * return:
+ * 	void
+ */
+template<class Model>
+void skinModelFromStatic(SkinModel& model);
+
+
+/* scoreForPixelStatic():
+ * 	Calculates the discriminant of a pixel value under a compile-time
+ * 	model, so every model value is folded into the code.
+ * args:
+ * 	@pix: The pixel to score.
+ * return:
+ * 	float: The discriminant value. Skin if greater than Model::t.
+ */
+template<class Model>
+float scoreForPixelStatic(RGB& pix);
+
+
+/* classifyForPixelStatic():
+ * 	Classifies a pixel value under a compile-time model.
+ * args:
+ * 	@pix: The pixel to classify.
+ * return:
+ * 	true: if the pixel is classified as skin.
+ * 	false: otherwise.
+ */
+template<class Model>
+bool classifyForPixelStatic(RGB& pix);
+
+#include "SkinModel.cpp"
+
+#endif
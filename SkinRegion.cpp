@@ -0,0 +1,360 @@
+/* SkinRegion.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for reasoning about the region of feature space that
+ * 	a skin model accepts.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <math.h>
+
+#include "image.h"
+#include "rgb.h"
+#include "SkinModel.h"
+#include "SkinRegion.h"
+#include "ColourSpace.h"
+#include "Parallel.h"
+
+
+// Functions
+
+/* scoreForFeaturesExact():
+ * 	Calculates the score of a model at a point in feature space,
+ * 	in double precision.
+ * args:
+ * 	@model: The model to score with.
+ * 	@x0: The first feature.
+ * 	@x1: The second feature.
+ * return:
+ * 	double: The score.
+ */
+double scoreForFeaturesExact(const SkinModel& model, double x0, double x1) {
+	double quad = model.inv[0][0] * x0 * x0
+		+ ((double)model.inv[0][1] + model.inv[1][0]) * x0 * x1
+		+ model.inv[1][1] * x1 * x1;
+	return -0.5 * quad + model.invMu[0] * x0 + model.invMu[1] * x1 + model.bias;
+}
+
+
+/* scoreMargin():
+ * 	Calculates how far a score must be from the threshold over a
+ * 	box before a decision is trusted. Float scores add up terms as
+ * 	large as the quadratic part, so the margin grows with them.
+ * args:
+ * 	@model: The model to score with.
+ * 	@lo: The smallest value of each feature.
+ * 	@hi: The largest value of each feature.
+ * return:
+ * 	double: The margin.
+ */
+double scoreMargin(const SkinModel& model, const double lo[2], const double hi[2]) {
+	double m0 = fmax(fabs(lo[0]), fabs(hi[0]));
+	double m1 = fmax(fabs(lo[1]), fabs(hi[1]));
+	double terms = 0.5 * (fabs(model.inv[0][0]) * m0 * m0
+		+ (fabs(model.inv[0][1]) + fabs(model.inv[1][0])) * m0 * m1
+		+ fabs(model.inv[1][1]) * m1 * m1)
+		+ fabs(model.invMu[0]) * m0 + fabs(model.invMu[1]) * m1
+		+ fabs(model.bias);
+	return 1e-5 * (1.0 + terms);
+}
+
+
+/* featureBoundsForColours():
+ * 	Bounds the features of every pixel whose channels lie within
+ * 	given ranges.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@lo: The smallest red, green and blue values.
+ * 	@hi: The largest red, green and blue values.
+ * 	@flo: Location to store the smallest value of each feature.
+ * 	@fhi: Location to store the largest value of each feature.
+ * return:
+ * 	void
+ */
+void featureBoundsForColours(bool isRGB, const int lo[3], const int hi[3], double flo[2], double fhi[2]) {
+	if(isRGB) {
+		// r/(r+g+b) grows with r and shrinks with g and b; a black
+		// pixel has features (0, 0), which the lower bounds include.
+		int sum;
+		sum = lo[0] + hi[1] + hi[2];
+		flo[0] = sum == 0 ? 0 : (double)lo[0] / sum;
+		sum = hi[0] + lo[1] + lo[2];
+		fhi[0] = sum == 0 ? 0 : (double)hi[0] / sum;
+		sum = hi[0] + lo[1] + hi[2];
+		flo[1] = sum == 0 ? 0 : (double)lo[1] / sum;
+		sum = lo[0] + hi[1] + lo[2];
+		fhi[1] = sum == 0 ? 0 : (double)hi[1] / sum;
+		if(lo[0] + lo[1] + lo[2] == 0) {
+			flo[0] = 0;
+			flo[1] = 0;
+		}
+	}
+	else {
+		// Features are linear, so each bound takes each channel's
+		// end that matches the sign of its weight.
+		for(int f = 0; f < 2; f++) {
+			flo[f] = 0;
+			fhi[f] = 0;
+			for(int c = 0; c < 3; c++) {
+				double w = yccWeights[f][c];
+				flo[f] += w * (w > 0 ? lo[c] : hi[c]);
+				fhi[f] += w * (w > 0 ? hi[c] : lo[c]);
+			}
+		}
+	}
+}
+
+
+/* maxScoreOnEdge():
+ * 	Calculates the largest score along one edge of a box, where one
+ * 	feature is fixed and the other varies.
+ * args:
+ * 	@model: The model to score with.
+ * 	@fixed: Which feature is fixed (0 or 1).
+ * 	@val: The value of the fixed feature.
+ * 	@lo: The smallest value of the varying feature.
+ * 	@hi: The largest value of the varying feature.
+ * return:
+ * 	double: The largest score on the edge.
+ */
+double maxScoreOnEdge(const SkinModel& model, int fixed, double val, double lo, double hi) {
+	int free = 1 - fixed;
+	double s01 = 0.5 * ((double)model.inv[0][1] + model.inv[1][0]);
+	double peak = (model.invMu[free] - s01 * val) / model.inv[free][free];
+	double x = fmin(fmax(peak, lo), hi);
+
+	return fixed == 0 ? scoreForFeaturesExact(model, val, x) : scoreForFeaturesExact(model, x, val);
+}
+
+
+/* classifyFeatureBox():
+ * 	Decides whether a box in feature space lies entirely inside or
+ * 	outside the region a model accepts.
+ * args:
+ * 	@model: The model and threshold.
+ * 	@lo: The smallest value of each feature.
+ * 	@hi: The largest value of each feature.
+ * return:
+ * 	int: REGION_INSIDE, REGION_OUTSIDE or REGION_MIXED.
+ */
+int classifyFeatureBox(const SkinModel& model, const double lo[2], const double hi[2]) {
+	// Only an ellipse (positive definite inverse) can be bounded
+	double s01 = 0.5 * ((double)model.inv[0][1] + model.inv[1][0]);
+	double det = (double)model.inv[0][0] * model.inv[1][1] - s01 * s01;
+	if(model.inv[0][0] <= 0 || det <= 0) {
+		return REGION_MIXED;
+	}
+
+	double margin = scoreMargin(model, lo, hi);
+
+	// Concave score is lowest at a corner
+	double low = fmin(fmin(scoreForFeaturesExact(model, lo[0], lo[1]),
+		scoreForFeaturesExact(model, lo[0], hi[1])),
+		fmin(scoreForFeaturesExact(model, hi[0], lo[1]),
+		scoreForFeaturesExact(model, hi[0], hi[1])));
+	if(low > model.t + margin) {
+		return REGION_INSIDE;
+	}
+
+	// and highest at its peak, or on an edge if the peak is outside
+	double peak[2];
+	peak[0] = (model.inv[1][1] * model.invMu[0] - s01 * model.invMu[1]) / det;
+	peak[1] = (model.inv[0][0] * model.invMu[1] - s01 * model.invMu[0]) / det;
+
+	double high;
+	if(peak[0] >= lo[0] && peak[0] <= hi[0] && peak[1] >= lo[1] && peak[1] <= hi[1]) {
+		high = scoreForFeaturesExact(model, peak[0], peak[1]);
+	}
+	else {
+		high = fmax(fmax(maxScoreOnEdge(model, 0, lo[0], lo[1], hi[1]),
+			maxScoreOnEdge(model, 0, hi[0], lo[1], hi[1])),
+			fmax(maxScoreOnEdge(model, 1, lo[1], lo[0], hi[0]),
+			maxScoreOnEdge(model, 1, hi[1], lo[0], hi[0])));
+	}
+	if(high < model.t - margin) {
+		return REGION_OUTSIDE;
+	}
+
+	return REGION_MIXED;
+}
+
+
+/* prepareSkinPrefilter():
+ * 	Calculates the box around the region a model accepts.
+ * args:
+ * 	@model: The model and threshold.
+ * 	@filter: Location to store the box.
+ * return:
+ * 	void
+ */
+void prepareSkinPrefilter(const SkinModel& model, SkinPrefilter& filter) {
+	double s01 = 0.5 * ((double)model.inv[0][1] + model.inv[1][0]);
+	double det = (double)model.inv[0][0] * model.inv[1][1] - s01 * s01;
+	double range = model.isRGB ? 1.0 : 130.0;
+	double flo[2] = { -range, -range }, fhi[2] = { range, range };
+
+	filter.isRGB = model.isRGB;
+	filter.never = false;
+
+	// Without an ellipse, accept every pixel value
+	if(model.inv[0][0] <= 0 || det <= 0) {
+		for(int f = 0; f < 2; f++) {
+			filter.lo[f] = flo[f];
+			filter.hi[f] = fhi[f];
+			filter.qlo[f] = -((int64_t)1 << 40);
+			filter.qhi[f] = (int64_t)1 << 40;
+		}
+		return;
+	}
+
+	double peak[2];
+	peak[0] = (model.inv[1][1] * model.invMu[0] - s01 * model.invMu[1]) / det;
+	peak[1] = (model.inv[0][0] * model.invMu[1] - s01 * model.invMu[0]) / det;
+	double top = scoreForFeaturesExact(model, peak[0], peak[1]);
+
+	// Bound the region where the score beats the threshold less the
+	// rounding margin. The first pass takes the margin over every
+	// reachable feature value; the second only over the first box.
+	for(int pass = 0; pass < 2; pass++) {
+		double reach = 2.0 * (top - (model.t - scoreMargin(model, flo, fhi)));
+		if(reach <= 0) {
+			reach = 0;
+			filter.never = true;
+		}
+
+		// Half-widths of the ellipse (x-p)^T S (x-p) < reach
+		double half[2];
+		half[0] = sqrt(reach * model.inv[1][1] / det);
+		half[1] = sqrt(reach * model.inv[0][0] / det);
+
+		for(int f = 0; f < 2; f++) {
+			flo[f] = peak[f] - half[f];
+			fhi[f] = peak[f] + half[f];
+		}
+	}
+
+	double scale = model.isRGB ? 65536.0 : 10000.0;
+	for(int f = 0; f < 2; f++) {
+		filter.lo[f] = flo[f];
+		filter.hi[f] = fhi[f];
+		filter.qlo[f] = (int64_t)floor(flo[f] * scale) - 1;
+		filter.qhi[f] = (int64_t)ceil(fhi[f] * scale) + 1;
+	}
+}
+
+
+/* passesSkinPrefilter():
+ * 	Tests whether a pixel value could be skin, using integer
+ * 	compares only.
+ * args:
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * 	@filter: The box to test against.
+ * return:
+ * 	true: if the pixel must still be scored.
+ * 	false: if the pixel is not skin.
+ */
+inline bool passesSkinPrefilter(int r, int g, int b, const SkinPrefilter& filter) {
+	if(filter.never) {
+		return false;
+	}
+
+	if(filter.isRGB) {
+		// r/(r+g+b) >= lo  <=>  r * 65536 >= qlo * (r+g+b)
+		int64_t sum = r + g + b;
+		int64_t x0 = (int64_t)r << 16;
+		int64_t x1 = (int64_t)g << 16;
+		return x0 >= filter.qlo[0] * sum && x0 <= filter.qhi[0] * sum
+			&& x1 >= filter.qlo[1] * sum && x1 <= filter.qhi[1] * sum;
+	}
+
+	// YCrCb features times 10000 are exact integers (see yccWeights)
+	int64_t x0 = 5000 * r - 4190 * g - 810 * b;
+	int64_t x1 = -1690 * r - 332 * g + 5000 * b;
+	return x0 >= filter.qlo[0] && x0 <= filter.qhi[0]
+		&& x1 >= filter.qlo[1] && x1 <= filter.qhi[1];
+}
+
+
+/* classifyForImageBlocks():
+ * 	Classifies skin pixels within an image a block at a time. Blocks
+ * 	whose colours all fall inside or all fall outside the accepted
+ * 	region are filled at once; only mixed blocks are scored pixel
+ * 	by pixel. The result matches classifyForImage() exactly.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@blockSize: The width and height of each block (e.g. 8 or 16).
+ * return:
+ * 	void
+ */
+void classifyForImageBlocks(ImageType& source, ImageType& dest, const SkinModel& model, int blockSize) {
+	// Variables
+	int rows, cols, levels;
+	RGB white(255, 255, 255), black(0, 0, 0);
+
+	// Get image metadata
+	source.getImageInfo(rows, cols, levels);
+	if(blockSize < 1) {
+		blockSize = 16;
+	}
+
+	SkinPrefilter filter;
+	prepareSkinPrefilter(model, filter);
+
+	// Loop through blocks, each band taking the block rows that start in it
+	parallelFor(rows, imageBands(rows, cols), [&](int begin, int end) {
+		RGB val;
+
+		for(int bi = (begin + blockSize - 1) / blockSize * blockSize; bi < end; bi += blockSize) {
+			int iEnd = bi + blockSize < rows ? bi + blockSize : rows;
+			for(int bj = 0; bj < cols; bj += blockSize) {
+				int jEnd = bj + blockSize < cols ? bj + blockSize : cols;
+				int lo[3] = { 255, 255, 255 }, hi[3] = { 0, 0, 0 };
+				double flo[2], fhi[2];
+
+				// Get colour range of block
+				for(int i = bi; i < iEnd; i++) {
+					for(int j = bj; j < jEnd; j++) {
+						source.getPixelVal(i, j, val);
+						lo[0] = val.r < lo[0] ? val.r : lo[0];
+						hi[0] = val.r > hi[0] ? val.r : hi[0];
+						lo[1] = val.g < lo[1] ? val.g : lo[1];
+						hi[1] = val.g > hi[1] ? val.g : hi[1];
+						lo[2] = val.b < lo[2] ? val.b : lo[2];
+						hi[2] = val.b > hi[2] ? val.b : hi[2];
+					}
+				}
+
+				featureBoundsForColours(model.isRGB, lo, hi, flo, fhi);
+				int region = classifyFeatureBox(model, flo, fhi);
+
+				// Fill decided blocks, score mixed ones
+				for(int i = bi; i < iEnd; i++) {
+					for(int j = bj; j < jEnd; j++) {
+						if(region == REGION_INSIDE) {
+							dest.setPixelVal(i, j, white);
+						}
+						else if(region == REGION_OUTSIDE) {
+							dest.setPixelVal(i, j, black);
+						}
+						else {
+							source.getPixelVal(i, j, val);
+							bool skin = passesSkinPrefilter(val.r, val.g, val.b, filter)
+								&& scoreForPixel(val, model) > model.t;
+							dest.setPixelVal(i, j, skin ? white : black);
+						}
+					}
+				}
+			}
+		}
+	});
+}
@@ -0,0 +1,117 @@
+/* SkinRegion.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for reasoning about the region of feature space
+ * 	that a skin model accepts, so whole groups of pixels can be
+ * 	decided without scoring each one.
+ *
+ * 	The score of a model is a concave quadratic in the features, so
+ * 	the accepted region (score > t) is an ellipse. Every test here
+ * 	keeps a safety margin well above float rounding, so it never
+ * 	decides a pixel differently from scoreForPixel().
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef SKINREGION_H_
+#define SKINREGION_H_
+
+#include <stdint.h>
+
+#include "image.h"
+#include "SkinModel.h"
+
+#define REGION_INSIDE  1     // Every point in the box is skin.
+#define REGION_OUTSIDE 0     // No point in the box is skin.
+#define REGION_MIXED   -1    // The box may hold both.
+
+/* SkinPrefilter:
+ * 	A box around the accepted ellipse of a model at one threshold,
+ * 	with the same bounds as integers on the raw colour values.
+ * 	Pixels outside the box are never skin.
+ */
+struct SkinPrefilter {
+	bool isRGB;          // isRGB: Colour scheme (1=RGB, 0=YCrCb).
+	bool never;          // never: No pixel can be skin.
+	double lo[2];        // lo: Smallest accepted value of each feature.
+	double hi[2];        // hi: Largest accepted value of each feature.
+	int64_t qlo[2];      // qlo: lo in 1/65536 (rg) or 1/10000 (YCrCb).
+	int64_t qhi[2];      // qhi: hi in the same units.
+};
+
+
+/* prepareSkinPrefilter():
+ * 	Calculates the box around the region a model accepts.
+ * args:
+ * 	@model: The model and threshold.
+ * 	@filter: Location to store the box.
+ * return:
+ * 	void
+ */
+void prepareSkinPrefilter(const SkinModel& model, SkinPrefilter& filter);
+
+
+/* passesSkinPrefilter():
+ * 	Tests whether a pixel value could be skin, using integer
+ * 	compares only.
+ * args:
+ * 	@r: Red value.
+ * 	@g: Green value.
+ * 	@b: Blue value.
+ * 	@filter: The box to test against.
+ * return:
+ * 	true: if the pixel must still be scored.
+ * 	false: if the pixel is not skin.
+ */
+inline bool passesSkinPrefilter(int r, int g, int b, const SkinPrefilter& filter);
+
+
+/* featureBoundsForColours():
+ * 	Bounds the features of every pixel whose channels lie within
+ * 	given ranges.
+ * args:
+ * 	@isRGB: The colour scheme (1=RGB, 0=YCrCb).
+ * 	@lo: The smallest red, green and blue values.
+ * 	@hi: The largest red, green and blue values.
+ * 	@flo: Location to store the smallest value of each feature.
+ * 	@fhi: Location to store the largest value of each feature.
+ * return:
+ * 	void
+ */
+void featureBoundsForColours(bool isRGB, const int lo[3], const int hi[3], double flo[2], double fhi[2]);
+
+
+/* classifyFeatureBox():
+ * 	Decides whether a box in feature space lies entirely inside or
+ * 	outside the region a model accepts.
+ * args:
+ * 	@model: The model and threshold.
+ * 	@lo: The smallest value of each feature.
+ * 	@hi: The largest value of each feature.
+ * return:
+ * 	int: REGION_INSIDE, REGION_OUTSIDE or REGION_MIXED.
+ */
+int classifyFeatureBox(const SkinModel& model, const double lo[2], const double hi[2]);
+
+
+/* classifyForImageBlocks():
+ * 	Classifies skin pixels within an image a block at a time. Blocks
+ * 	whose colours all fall inside or all fall outside the accepted
+ * 	region are filled at once; only mixed blocks are scored pixel
+ * 	by pixel. The result matches classifyForImage() exactly.
+ * args:
+ * 	@source: The image containing the pixels to classify.
+ * 	@dest: The image to output the classified pixels.
+ * 	@model: The model and threshold to classify with.
+ * 	@blockSize: The width and height of each block (e.g. 8 or 16).
+ * return:
+ * 	void
+ */
+void classifyForImageBlocks(ImageType& source, ImageType& dest, const SkinModel& model, int blockSize);
+
+#include "SkinRegion.cpp"
+
+#endif
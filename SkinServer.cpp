@@ -0,0 +1,446 @@
+/* SkinServer.cpp:
+ * 	Implementation file for respective header file. Contains the
+ * 	definitions for a long-running service that classifies frames
+ * 	sent over a Unix domain socket, and a client for it.
+ * authors:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+
+// Libraries
+#include <iostream>
+#include <future>
+#include <mutex>
+#include <ctype.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "image.h"
+#include "rgb.h"
+#include "SkinModel.h"
+#include "SkinServer.h"
+#include "ClassifySkin.h"
+#include "Parallel.h"
+#include "Pipeline.h"
+
+#define FRAME_MAX_PIXELS (64L << 20)   // Largest frame accepted.
+
+
+// Variables
+
+volatile sig_atomic_t serverStopping = 0;
+int serverSocket = -1;
+
+
+// Functions
+
+/* ServerRequest:
+ * 	A frame waiting to be classified by the worker pool.
+ */
+struct ServerRequest {
+	const unsigned char* pixels;     // pixels: Interleaved RGB values.
+	long count;                      // count: Number of pixels.
+	std::vector<unsigned char> mask; // mask: Classified pixels.
+	std::promise<void> done;         // done: Set once mask is filled.
+};
+
+
+/* ServerConnections:
+ * 	The open connections of a server, so they can be shut down and
+ * 	joined when it stops. A slot whose fd is -1 has finished.
+ */
+struct ServerConnections {
+	std::mutex lock;
+	std::vector<int> fds;              // fds: Socket of each slot.
+	std::vector<std::thread> threads;  // threads: Thread of each slot.
+};
+
+
+/* readFully():
+ * 	Reads an exact number of bytes from a socket.
+ * args:
+ * 	@fd: The socket to read from.
+ * 	@data: Location to store the bytes.
+ * 	@size: The number of bytes to read.
+ * return:
+ * 	true: if every byte was read.
+ * 	false: if the connection closed or failed first.
+ */
+bool readFully(int fd, void* data, size_t size) {
+	char* pos = (char*)data;
+	while(size > 0) {
+		ssize_t n = recv(fd, pos, size, 0);
+		if(n < 0 && errno == EINTR) {
+			continue;
+		}
+		if(n <= 0) {
+			return false;
+		}
+		pos += n;
+		size -= n;
+	}
+	return true;
+}
+
+
+/* writeFully():
+ * 	Writes an exact number of bytes to a socket.
+ * args:
+ * 	@fd: The socket to write to.
+ * 	@data: The bytes to write.
+ * 	@size: The number of bytes to write.
+ * return:
+ * 	true: if every byte was written.
+ * 	false: if the connection closed or failed first.
+ */
+bool writeFully(int fd, const void* data, size_t size) {
+	const char* pos = (const char*)data;
+	while(size > 0) {
+		ssize_t n = send(fd, pos, size, MSG_NOSIGNAL);
+		if(n < 0 && errno == EINTR) {
+			continue;
+		}
+		if(n <= 0) {
+			return false;
+		}
+		pos += n;
+		size -= n;
+	}
+	return true;
+}
+
+
+/* parsePPMBuffer():
+ * 	Reads the header of a P6 image held in memory.
+ * args:
+ * 	@data: The image bytes.
+ * 	@size: The number of image bytes.
+ * 	@rows: Location to output the number of rows.
+ * 	@cols: Location to output the number of columns.
+ * 	@offset: Location to output where the pixel values begin.
+ * return:
+ * 	true: if the header is valid and the pixel values are complete.
+ * 	false: otherwise.
+ */
+bool parsePPMBuffer(const unsigned char* data, size_t size, int& rows, int& cols, size_t& offset) {
+	long values[3];
+	size_t pos = 2;
+
+	if(size < 2 || data[0] != 'P' || data[1] != '6') {
+		return false;
+	}
+
+	// Read width, height and max value, skipping comments
+	for(int k = 0; k < 3; k++) {
+		while(pos < size && (isspace(data[pos]) || data[pos] == '#')) {
+			if(data[pos] == '#') {
+				while(pos < size && data[pos] != '\n') {
+					pos++;
+				}
+			}
+			else {
+				pos++;
+			}
+		}
+		if(pos >= size || !isdigit(data[pos])) {
+			return false;
+		}
+		values[k] = 0;
+		while(pos < size && isdigit(data[pos]) && values[k] < FRAME_MAX_PIXELS) {
+			values[k] = values[k] * 10 + (data[pos] - '0');
+			pos++;
+		}
+	}
+
+	// Single whitespace separates header from pixels
+	pos++;
+
+	cols = (int)values[0];
+	rows = (int)values[1];
+	offset = pos;
+	return values[2] >= 1 && values[2] <= 255 && (long)rows * cols <= FRAME_MAX_PIXELS
+		&& pos <= size && size - pos == (size_t)rows * cols * 3;
+}
+
+
+/* serveConnection():
+ * 	Answers the frames sent over one connection, in order, until
+ * 	the client disconnects or the server shuts the socket down.
+ * args:
+ * 	@fd: The connected socket.
+ * 	@slot: The connection's slot in conns.
+ * 	@conns: The server's open connections.
+ * 	@queue: The queue feeding the worker pool.
+ * return:
+ * 	void
+ */
+void serveConnection(int fd, size_t slot, ServerConnections* conns,
+		BoundedQueue<ServerRequest*>* queue) {
+	std::vector<unsigned char> payload;
+	FrameHeader header;
+
+	while(readFully(fd, &header, sizeof(header))) {
+		FrameHeader reply;
+		ServerRequest request;
+		int rows = header.rows, cols = header.cols;
+		size_t offset = 0;
+		bool valid = header.magic == FRAME_MAGIC
+			&& header.bytes <= FRAME_MAX_PIXELS * 3 + 64;
+
+		if(!valid) {
+			break;
+		}
+
+		// Read payload
+		payload.resize(header.bytes);
+		if(!readFully(fd, payload.data(), payload.size())) {
+			break;
+		}
+
+		if(header.kind == FRAME_PPM) {
+			valid = parsePPMBuffer(payload.data(), payload.size(), rows, cols, offset);
+		}
+		else {
+			valid = header.kind == FRAME_RAW
+				&& (long)rows * cols <= FRAME_MAX_PIXELS
+				&& payload.size() == (size_t)rows * cols * 3;
+		}
+
+		reply.magic = FRAME_MAGIC;
+		reply.kind = valid ? FRAME_OK : FRAME_ERROR;
+		reply.rows = valid ? rows : 0;
+		reply.cols = valid ? cols : 0;
+		reply.bytes = 0;
+
+		// Hand frame to worker pool and wait for its mask
+		if(valid) {
+			request.pixels = payload.data() + offset;
+			request.count = (long)rows * cols;
+			request.mask.resize(request.count);
+			std::future<void> done = request.done.get_future();
+			if(!queue->push(&request)) {
+				break;
+			}
+			done.wait();
+			reply.bytes = request.mask.size();
+		}
+
+		if(!writeFully(fd, &reply, sizeof(reply))
+				|| !writeFully(fd, request.mask.data(), reply.bytes)) {
+			break;
+		}
+	}
+
+	std::lock_guard<std::mutex> guard(conns->lock);
+	close(fd);
+	conns->fds[slot] = -1;
+}
+
+
+/* runSkinServer():
+ * 	Listens on a Unix domain socket and classifies frames until
+ * 	stopSkinServer() is called. Each connection is served by its own
+ * 	thread; frames from all connections are classified by a shared
+ * 	pool of workers that take several waiting frames at once.
+ * args:
+ * 	@socketPath: The path to bind the socket to.
+ * 	@model: The model and threshold to classify with.
+ * 	@workers: The number of classifying threads (<1 for default).
+ * 	@maxBatch: The most frames a worker takes at once.
+ * return:
+ * 	void
+ */
+void runSkinServer(char socketPath[], const SkinModel& model, int workers, int maxBatch) {
+	// Variables
+	struct sockaddr_un addr;
+	std::vector<std::thread> pool;
+	ServerConnections conns;
+	BoundedQueue<ServerRequest*> queue(1024);
+
+	if(workers < 1) {
+		workers = defaultThreadCount();
+	}
+	if(maxBatch < 1) {
+		maxBatch = 1;
+	}
+
+	// Bind and listen on socket
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if(strlen(socketPath) >= sizeof(addr.sun_path)) {
+		std::cout << "Error: Socket path too long " << socketPath << std::endl;
+		exit(1);
+	}
+	strcpy(addr.sun_path, socketPath);
+	unlink(socketPath);
+
+	serverSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(serverSocket < 0
+			|| bind(serverSocket, (struct sockaddr*)&addr, sizeof(addr)) != 0
+			|| listen(serverSocket, 64) != 0) {
+		std::cout << "Error: Could not listen on " << socketPath << std::endl;
+		exit(1);
+	}
+
+	// Start worker pool
+	for(int k = 0; k < workers; k++) {
+		pool.push_back(std::thread([&queue, &model, maxBatch] {
+			std::vector<ServerRequest*> batch;
+			while(queue.popBatch(batch, maxBatch) > 0) {
+				for(size_t b = 0; b < batch.size(); b++) {
+					classifyForBuffer(batch[b]->pixels, batch[b]->count,
+						model, batch[b]->mask.data());
+					batch[b]->done.set_value();
+				}
+				batch.clear();
+			}
+		}));
+	}
+
+	// Accept connections until asked to stop
+	while(!serverStopping) {
+		int fd = accept(serverSocket, NULL, NULL);
+		if(fd < 0) {
+			if(errno == EINTR || errno == ECONNABORTED) {
+				continue;
+			}
+			break;
+		}
+
+		// Reuse the slot of a finished connection if there is one
+		std::lock_guard<std::mutex> guard(conns.lock);
+		size_t slot = 0;
+		while(slot < conns.fds.size() && conns.fds[slot] >= 0) {
+			slot++;
+		}
+		if(slot == conns.fds.size()) {
+			conns.fds.push_back(fd);
+			conns.threads.push_back(std::thread());
+		}
+		else {
+			conns.threads[slot].join();
+			conns.fds[slot] = fd;
+		}
+		conns.threads[slot] = std::thread(serveConnection, fd, slot, &conns, &queue);
+	}
+
+	// Shut down open connections and wait for them before the pool
+	// stops, since their requests live on their own stacks.
+	close(serverSocket);
+	unlink(socketPath);
+	{
+		std::lock_guard<std::mutex> guard(conns.lock);
+		for(size_t k = 0; k < conns.fds.size(); k++) {
+			if(conns.fds[k] >= 0) {
+				shutdown(conns.fds[k], SHUT_RDWR);
+			}
+		}
+	}
+	for(size_t k = 0; k < conns.threads.size(); k++) {
+		conns.threads[k].join();
+	}
+	queue.close();
+	for(size_t k = 0; k < pool.size(); k++) {
+		pool[k].join();
+	}
+}
+
+
+/* stopSkinServer():
+ * 	Asks a running server to stop accepting connections. Safe to
+ * 	call from a signal handler.
+ * return:
+ * 	void
+ */
+void stopSkinServer() {
+	serverStopping = 1;
+	if(serverSocket >= 0) {
+		shutdown(serverSocket, SHUT_RDWR);
+	}
+}
+
+
+/* classifyRemote():
+ * 	Sends an image to a running server and stores the mask it returns.
+ * args:
+ * 	@socketPath: The path of the server's socket.
+ * 	@image: The image to classify.
+ * 	@mask: The image to output the classified pixels (white=skin).
+ * return:
+ * 	void
+ */
+void classifyRemote(char socketPath[], ImageType& image, ImageType& mask) {
+	// Variables
+	struct sockaddr_un addr;
+	int rows, cols, levels;
+	FrameHeader header;
+	RGB val;
+
+	// Pack pixels as raw RGB
+	image.getImageInfo(rows, cols, levels);
+	std::vector<unsigned char> pixels((size_t)rows * cols * 3);
+	for(int i = 0; i < rows; i++) {
+		for(int j = 0; j < cols; j++) {
+			image.getPixelVal(i, j, val);
+			pixels[((size_t)i * cols + j) * 3] = val.r;
+			pixels[((size_t)i * cols + j) * 3 + 1] = val.g;
+			pixels[((size_t)i * cols + j) * 3 + 2] = val.b;
+		}
+	}
+
+	// Connect to server
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0 || connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+		std::cout << "Error: Could not connect to " << socketPath << std::endl;
+		exit(1);
+	}
+
+	// Send frame and receive mask
+	header.magic = FRAME_MAGIC;
+	header.kind = FRAME_RAW;
+	header.rows = rows;
+	header.cols = cols;
+	header.bytes = pixels.size();
+
+	if(!writeFully(fd, &header, sizeof(header))
+			|| !writeFully(fd, pixels.data(), pixels.size())
+			|| !readFully(fd, &header, sizeof(header))
+			|| header.magic != FRAME_MAGIC || header.kind != FRAME_OK
+			|| header.bytes != (uint32_t)rows * cols) {
+		std::cout << "Error: Server could not classify frame" << std::endl;
+		exit(1);
+	}
+
+	std::vector<unsigned char> result(header.bytes);
+	if(!readFully(fd, result.data(), result.size())) {
+		std::cout << "Error: Server could not classify frame" << std::endl;
+		exit(1);
+	}
+	close(fd);
+
+	// Unpack mask
+	for(int i = 0; i < rows; i++) {
+		for(int j = 0; j < cols; j++) {
+			int level = result[(size_t)i * cols + j];
+			val.r = level;
+			val.g = level;
+			val.b = level;
+			mask.setPixelVal(i, j, val);
+		}
+	}
+}
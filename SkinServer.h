@@ -0,0 +1,83 @@
+/* SkinServer.h:
+ * 	Header file for the respective implementation file. Contains
+ * 	the declarations for a long-running service that classifies
+ * 	frames sent over a Unix domain socket, and a client for it.
+ *
+ * 	Every message in either direction is a FrameHeader followed by
+ * 	header.bytes bytes of payload. A request payload holds either raw
+ * 	interleaved RGB values (rows and cols given in the header) or a
+ * 	whole P6 image (rows and cols read from the image). The response
+ * 	payload holds one byte per pixel: 255 for skin, 0 otherwise.
+ * author:
+ * 	Froilan Luna-Lopez
+ * 		University of Nevada, Reno
+ * 		CS 479 - Pattern Recognition
+ * date:
+ * 	19 October 2026
+ */
+
+#ifndef SKINSERVER_H_
+#define SKINSERVER_H_
+
+#include <stdint.h>
+
+#include "image.h"
+#include "SkinModel.h"
+
+#define FRAME_MAGIC  0x534b4e31   // "SKN1"
+#define FRAME_RAW    0            // Payload is raw RGB values.
+#define FRAME_PPM    1            // Payload is a P6 image.
+#define FRAME_OK     0            // Response status: classified.
+#define FRAME_ERROR  1            // Response status: bad request.
+
+/* FrameHeader:
+ * 	The fixed-size header leading every message.
+ */
+struct FrameHeader {
+	uint32_t magic;      // magic: Always FRAME_MAGIC.
+	uint32_t kind;       // kind: Payload format (request) or status (response).
+	uint32_t rows;       // rows: Number of pixel rows.
+	uint32_t cols;       // cols: Number of pixel columns.
+	uint32_t bytes;      // bytes: Length of the payload that follows.
+};
+
+
+/* runSkinServer():
+ * 	Listens on a Unix domain socket and classifies frames until
+ * 	stopSkinServer() is called. Each connection is served by its own
+ * 	thread; frames from all connections are classified by a shared
+ * 	pool of workers that take several waiting frames at once.
+ * args:
+ * 	@socketPath: The path to bind the socket to.
+ * 	@model: The model and threshold to classify with.
+ * 	@workers: The number of classifying threads (<1 for default).
+ * 	@maxBatch: The most frames a worker takes at once.
+ * return:
+ * 	void
+ */
+void runSkinServer(char socketPath[], const SkinModel& model, int workers, int maxBatch);
+
+
+/* stopSkinServer():
+ * 	Asks a running server to stop accepting connections. Safe to
+ * 	call from a signal handler.
+ * return:
+ * 	void
+ */
+void stopSkinServer();
+
+
+/* classifyRemote():
+ * 	Sends an image to a running server and stores the mask it returns.
+ * args:
+ * 	@socketPath: The path of the server's socket.
+ * 	@image: The image to classify.
+ * 	@mask: The image to output the classified pixels (white=skin).
+ * return:
+ * 	void
+ */
+void classifyRemote(char socketPath[], ImageType& image, ImageType& mask);
+
+#include "SkinServer.cpp"
+
+#endif
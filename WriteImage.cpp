@@ -17,14 +17,96 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
 
 using namespace std;
 
 #include "image.h"
+#include "Parallel.h"
+#include "MemoryStats.h"
 
 
 // Functions
 
+/* formatImageHeader():
+ * 	Formats the header of a PGM or PPM image.
+ * args:
+ * 	@header: Location to store the header text (at least 64 bytes).
+ * 	@N: Number of rows.
+ * 	@M: Number of columns.
+ * 	@Q: Max value possible for pixel values.
+ * 	@type: The type of file (true=PPM, false=PGM).
+ * return:
+ * 	int: The length of the header in bytes.
+ */
+int formatImageHeader(char header[], int N, int M, int Q, bool type)
+{
+ return snprintf(header, 64, "%s\n%d %d\n%d\n", type ? "P6" : "P5", M, N, Q);
+}
+
+
+/* writeImageBuffer():
+ * 	Output a PGM or PPM image straight from contiguous 8-bit pixel
+ * 	storage. The header and pixels are emitted with one gathered
+ * 	write, without copying the pixels.
+ * args:
+ * 	@fname: Path to file to output image information to.
+ * 	@data: The pixel values, row by row (interleaved RGB for PPM).
+ * 	@N: Number of rows.
+ * 	@M: Number of columns.
+ * 	@Q: Max value possible for pixel values.
+ * 	@type: The type of file to write (true=PPM, false=PGM).
+ */
+void writeImageBuffer(char fname[], const unsigned char* data, int N, int M, int Q, bool type)
+{
+ char header[64];
+ struct iovec iov[2];
+ int fd;
+
+ fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+ if (fd < 0) {
+   cout << "Can't open file: " << fname << endl;
+   exit(1);
+ }
+
+ iov[0].iov_base = header;
+ iov[0].iov_len = formatImageHeader(header, N, M, Q, type);
+ iov[1].iov_base = const_cast<unsigned char *>(data);
+ iov[1].iov_len = (size_t)(type ? 3 : 1)*M*N;
+
+ // writev may stop early, so keep going from where it left off
+
+ int first = 0;
+
+ while (first < 2) {
+   ssize_t n = writev(fd, iov + first, 2 - first);
+
+   if (n < 0 && errno == EINTR)
+     continue;
+   if (n <= 0) {
+     cout << "Can't write image " << fname << endl;
+     exit(1);
+   }
+
+   while (first < 2 && (size_t)n >= iov[first].iov_len) {
+     n -= iov[first].iov_len;
+     first++;
+   }
+   if (first < 2) {
+     iov[first].iov_base = (char *)iov[first].iov_base + n;
+     iov[first].iov_len -= n;
+   }
+ }
+
+ close(fd);
+}
+
+
 /* writeImagePGM():
  *  Output the PGM image information to a given file location.
  * args:
@@ -36,11 +118,11 @@ void writeImagePGM(char fname[], ImageType& image)
  int i, j;
  int N, M, Q;
  unsigned char *charImage;
- ofstream ofp;
 
  image.getImageInfo(N, M, Q);
 
  charImage = (unsigned char *) new unsigned char [M*N];
+ trackAlloc(MEMORY_IO, M*N);
 
  // convert the integer values to unsigned char
 
@@ -52,26 +134,9 @@ void writeImagePGM(char fname[], ImageType& image)
      charImage[i*M+j]=(unsigned char)val;
    }
 
- ofp.open(fname, ios::out | ios::binary);
-
- if (!ofp) {
-   cout << "Can't open file: " << fname << endl;
-   exit(1);
- }
-
- ofp << "P5" << endl;
- ofp << M << " " << N << endl;
- ofp << Q << endl;
-
- ofp.write( reinterpret_cast<char *>(charImage), (M*N)*sizeof(unsigned char));
-
- if (ofp.fail()) {
-   cout << "Can't write image " << fname << endl;
-   exit(0);
- }
-
- ofp.close();
+ writeImageBuffer(fname, charImage, N, M, Q, false);
 
+ trackFree(MEMORY_IO, M*N);
  delete [] charImage;
 
 }
@@ -88,11 +153,11 @@ void writeImagePPM(char fname[], ImageType& image)
  int i, j;
  int N, M, Q;
  unsigned char *charImage;
- ofstream ofp;
 
  image.getImageInfo(N, M, Q);
 
  charImage = (unsigned char *) new unsigned char [3*M*N];
+ trackAlloc(MEMORY_IO, 3*M*N);
 
  RGB val;
 
@@ -102,28 +167,100 @@ void writeImagePPM(char fname[], ImageType& image)
      charImage[i*3*M+j]=(unsigned char)val.r;
      charImage[i*3*M+j+1]=(unsigned char)val.g;
      charImage[i*3*M+j+2]=(unsigned char)val.b;
-     //cout << val.r << " " << val.g << " " << val.b << endl;
    }
 
- ofp.open(fname, ios::out | ios::binary);
+ writeImageBuffer(fname, charImage, N, M, Q, true);
+
+ trackFree(MEMORY_IO, 3*M*N);
+ delete [] charImage;
+}
+
+
+/* writeImageParallel():
+ * 	Output a PGM or PPM image using several threads. The file is
+ * 	preallocated, then each thread converts a band of rows to 8-bit
+ * 	values and writes it at its own offset in the file.
+ * args:
+ * 	@fname: Path to file to output image information to.
+ * 	@image: The location that stores the image information.
+ * 	@type: The type of file to write (true=PPM, false=PGM).
+ * 	@threads: The number of threads to use (<1 for default).
+ */
+void writeImageParallel(char fname[], ImageType& image, bool type, int threads)
+{
+ int N, M, Q;
+ int fd, headerLen;
+ char header[64];
+ std::atomic<bool> failed(false);
 
- if (!ofp) {
+ image.getImageInfo(N, M, Q);
+
+ const int channels = type ? 3 : 1;
+ const size_t rowBytes = (size_t)channels*M;
+
+ fd = open(fname, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+ if (fd < 0) {
    cout << "Can't open file: " << fname << endl;
    exit(1);
  }
 
- ofp << "P6" << endl;
- ofp << M << " " << N << endl;
- ofp << Q << endl;
+ // write header and size the file so bands can land anywhere
 
- ofp.write( reinterpret_cast<char *>(charImage), (3*M*N)*sizeof(unsigned char));
+ headerLen = formatImageHeader(header, N, M, Q, type);
 
- if (ofp.fail()) {
+ if (pwrite(fd, header, headerLen, 0) != headerLen
+     || ftruncate(fd, headerLen + rowBytes*N) != 0) {
    cout << "Can't write image " << fname << endl;
-   exit(0);
+   exit(1);
  }
 
- ofp.close();
+ parallelFor(N, threads, [&](int begin, int end) {
+   unsigned char *band = new unsigned char [rowBytes*(end-begin)];
+   trackAlloc(MEMORY_IO, rowBytes*(end-begin));
+   int val;
+   RGB pix;
+
+   for(int i=begin; i<end; i++) {
+     unsigned char *row = band + rowBytes*(i-begin);
+     for(int j=0; j<M; j++) {
+       if (type) {
+         image.getPixelVal(i, j, pix);
+         row[j*3]=(unsigned char)pix.r;
+         row[j*3+1]=(unsigned char)pix.g;
+         row[j*3+2]=(unsigned char)pix.b;
+       }
+       else {
+         image.getPixelVal(i, j, val);
+         row[j]=(unsigned char)val;
+       }
+     }
+   }
+
+   // pwrite may stop early, so keep going from where it left off
 
- delete [] charImage;
+   size_t done = 0, total = rowBytes*(end-begin);
+   off_t offset = headerLen + rowBytes*begin;
+
+   while (done < total) {
+     ssize_t n = pwrite(fd, band + done, total - done, offset + done);
+     if (n < 0 && errno == EINTR)
+       continue;
+     if (n <= 0) {
+       failed = true;
+       break;
+     }
+     done += n;
+   }
+
+   trackFree(MEMORY_IO, rowBytes*(end-begin));
+   delete [] band;
+ });
+
+ close(fd);
+
+ if (failed) {
+   cout << "Can't write image " << fname << endl;
+   exit(1);
+ }
 }
@@ -20,6 +20,34 @@ void writeImagePGM(char fname[], ImageType& image);
  */
 void writeImagePPM(char fname[], ImageType& image);
 
+
+/* writeImageBuffer():
+ * 	Output a PGM or PPM image straight from contiguous 8-bit pixel
+ * 	storage. The header and pixels are emitted with one gathered
+ * 	write, without copying the pixels.
+ * args:
+ * 	@fname: Path to file to output image information to.
+ * 	@data: The pixel values, row by row (interleaved RGB for PPM).
+ * 	@N: Number of rows.
+ * 	@M: Number of columns.
+ * 	@Q: Max value possible for pixel values.
+ * 	@type: The type of file to write (true=PPM, false=PGM).
+ */
+void writeImageBuffer(char fname[], const unsigned char* data, int N, int M, int Q, bool type);
+
+
+/* writeImageParallel():
+ * 	Output a PGM or PPM image using several threads. The file is
+ * 	preallocated, then each thread converts a band of rows to 8-bit
+ * 	values and writes it at its own offset in the file.
+ * args:
+ * 	@fname: Path to file to output image information to.
+ * 	@image: The location that stores the image information.
+ * 	@type: The type of file to write (true=PPM, false=PGM).
+ * 	@threads: The number of threads to use (<1 for default).
+ */
+void writeImageParallel(char fname[], ImageType& image, bool type, int threads = 0);
+
 #include "WriteImage.cpp"
 
 #endif
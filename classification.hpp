@@ -16,21 +16,25 @@
 #include <string>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 #include <math.h>
 #include "Eigen/Dense"
+#include "PointFile.h"
+#include "DecisionGrid.h"
 
 // Classifier.cpp
 
 void bayesCaseOne(Eigen::Matrix<float, 2, 1> muOne, Eigen::Matrix<float, 2, 1> muTwo, float varianceOne, float varianceTwo, float priorOne, float priorTwo, const std::string& sourceFile, const std::string& destFile) {
-    std::ifstream inFile;
-    inFile.open(sourceFile.c_str());
+    PointColumns points;
+    loadPointColumns(sourceFile.c_str(), points);
+    reportMalformedLines(sourceFile.c_str(), points);
 
     // Open file for writing classifications to
     std::ofstream outFile;
     outFile.open(destFile.c_str());
 
-    float xf, yf, _f;
-    while (inFile >> xf >> yf >> _f) {
+    for (size_t k = 0; k < points.x.size(); k++) {
+        float xf = points.x[k], yf = points.y[k];
         Eigen::Matrix<float, 2, 1> x;
         x << xf, yf;
 
@@ -52,22 +56,22 @@ void bayesCaseOne(Eigen::Matrix<float, 2, 1> muOne, Eigen::Matrix<float, 2, 1> m
         outFile << std::endl;
     }
 
-    inFile.close();
     outFile.close();
 
 }
 
 
 void bayesCaseTwo(const Eigen::Matrix<float, 2, 1>& muOne, const Eigen::Matrix<float, 2, 1>& muTwo, const Eigen::Matrix2f& sigmaOne, const Eigen::Matrix2f& sigmaTwo, float priorOne, float priorTwo, const std::string& sourceFile, const std::string& destFile) {
-    std::ifstream inFile;
-    inFile.open(sourceFile);
+    PointColumns points;
+    loadPointColumns(sourceFile.c_str(), points);
+    reportMalformedLines(sourceFile.c_str(), points);
 
     // Open file for writing classifications to
     std::ofstream outFile;
     outFile.open(destFile);
 
-    float xf, yf, _f;
-    while(inFile >> xf >> yf >> _f) {
+    for(size_t k = 0; k < points.x.size(); k++) {
+        float xf = points.x[k], yf = points.y[k];
         Eigen::Vector2f x(xf, yf);
         float discrimOne = ((sigmaOne.inverse() * muOne).transpose() * x)(0) - (0.5 * muOne.transpose() * sigmaOne.inverse() * muOne);
         float discrimTwo = ((sigmaTwo.inverse() * muTwo).transpose() * x)(0) - (0.5 * muTwo.transpose() * sigmaTwo.inverse() * muTwo);
@@ -89,7 +93,6 @@ void bayesCaseTwo(const Eigen::Matrix<float, 2, 1>& muOne, const Eigen::Matrix<f
     }
 
     // Close files
-    inFile.close();
     outFile.close();
 
 }
@@ -97,39 +100,45 @@ void bayesCaseTwo(const Eigen::Matrix<float, 2, 1>& muOne, const Eigen::Matrix<f
 
 void bayesCaseThree(const Eigen::Vector2f muOne, const Eigen::Vector2f muTwo, 
     const Eigen::Matrix2f sigmaOne, const Eigen::Matrix2f sigmaTwo, float priorOne, float priorTwo,
-    const std::string& sourceFile, const std::string& destFile) {
-
-    std::ifstream inFile;
-    inFile.open(sourceFile);
+    const std::string& sourceFile, const std::string& destFile, int gridResolution = 0) {
+
+    PointColumns points;
+    loadPointColumns(sourceFile.c_str(), points);
+    reportMalformedLines(sourceFile.c_str(), points);
+
+    // Decide whole cells of the data's box up front when asked
+    DecisionGrid grid;
+    if (gridResolution > 0 && !points.x.empty()) {
+        float xMin = points.x[0], xMax = points.x[0], yMin = points.y[0], yMax = points.y[0];
+        for (size_t k = 1; k < points.x.size(); k++) {
+            xMin = std::min(xMin, points.x[k]);
+            xMax = std::max(xMax, points.x[k]);
+            yMin = std::min(yMin, points.y[k]);
+            yMax = std::max(yMax, points.y[k]);
+        }
+        buildDecisionGrid(muOne, muTwo, sigmaOne, sigmaTwo, priorOne, priorTwo,
+            xMin, xMax, yMin, yMax, gridResolution, grid);
+    }
 
     // Open file for writing classifications to
     std::ofstream outFile;
     outFile.open(destFile);
 
-    float xf, yf, _f;
-    while (inFile >> xf >> yf >> _f) {
-        Eigen::Vector2f x(xf, yf);
-        float discrimOne = (x.transpose() * (-0.5 * sigmaOne.inverse()) * x) + ((sigmaOne.inverse() * muOne).transpose() * x)(0) +(-0.5 * muOne.transpose() * sigmaOne.inverse() * muOne) + (-0.5 * log(sigmaOne.determinant()));
-        float discrimTwo = (x.transpose() * (-0.5 * sigmaTwo.inverse()) * x) + ((sigmaTwo.inverse() * muTwo).transpose() * x)(0) +(-0.5 * muTwo.transpose() * sigmaTwo.inverse() * muTwo) + (-0.5 * log(sigmaTwo.determinant()));
-
-        if (priorOne != priorTwo) {
-            discrimOne += log(priorOne);
-            discrimTwo += log(priorTwo);
-        }
-
-        // Save choice
-        outFile << xf << " " << yf << " ";
-        if (discrimOne < discrimTwo) {
-            outFile << "2";
+    for (size_t k = 0; k < points.x.size(); k++) {
+        float xf = points.x[k], yf = points.y[k];
+        int choice;
+        if (gridResolution > 0) {
+            choice = classForGrid(grid, xf, yf);
         }
         else {
-            outFile << "1";
+            choice = classForPointExact(Eigen::Vector2f(xf, yf), muOne, muTwo, sigmaOne, sigmaTwo, priorOne, priorTwo);
         }
-        outFile << std::endl;
+
+        // Save choice
+        outFile << xf << " " << yf << " " << choice << std::endl;
     }
 
     // Close files
-    inFile.close();
     outFile.close();
 }
 
@@ -149,17 +158,18 @@ void classifyEuclidean(Eigen::Matrix<float, 2, 1> means1,
 	Eigen::Matrix<float, 2, 1> means2,
 	std::string sourceFile,
 	std::string destFile) {
-	// Open file for reading feature sets
-	std::ifstream inFile;
-	inFile.open(sourceFile);
+	// Read feature sets
+	PointColumns points;
+	loadPointColumns(sourceFile.c_str(), points);
+	reportMalformedLines(sourceFile.c_str(), points);
 
 	// Open file for writing classifications to
 	std::ofstream outFile;
 	outFile.open(destFile);
 
-	// Read features from source file
-	float xf, yf, _f;
-	while(inFile >> xf >> yf >> _f) {
+	// Go through features from source file
+	for(size_t k = 0; k < points.x.size(); k++) {
+		float xf = points.x[k], yf = points.y[k];
 		// Compute distance from first mean
 		float dist1 = std::pow((xf - means1(0, 0)), 2)
 			+ std::pow((yf - means1(1, 0)), 2);
@@ -180,7 +190,6 @@ void classifyEuclidean(Eigen::Matrix<float, 2, 1> means1,
 	}
 
 	// Close files
-	inFile.close();
 	outFile.close();
 }
 
@@ -199,17 +208,14 @@ void classifyEuclidean(Eigen::Matrix<float, 2, 1> means1,
  * 	@counts.
  */
 void misclassifyCount(std::string trueSrc, std::string classSrc, std::vector<int>& counts) {
-	// Open files for reading
-	std::ifstream trueFile;
-	std::ifstream classFile;
-	
-	trueFile.open(trueSrc);
-	classFile.open(classSrc);
+	// Read both files
+	PointColumns truePoints, classPoints;
+	loadPointColumns(trueSrc.c_str(), truePoints);
+	loadPointColumns(classSrc.c_str(), classPoints);
 
 	// Iterate through values in files and count misclassifications
-	float trueVal, classVal;
-	while(trueFile >> trueVal >> trueVal >> trueVal
-			&& classFile >> classVal >> classVal >> classVal) {
+	for(size_t k = 0; k < truePoints.id.size() && k < classPoints.id.size(); k++) {
+		float trueVal = truePoints.id[k], classVal = classPoints.id[k];
 		if(trueVal != classVal) {
 			if(trueVal == 1) {
 				counts[0] += 1;
@@ -220,10 +226,6 @@ void misclassifyCount(std::string trueSrc, std::string classSrc, std::vector<int
 		}
 	}
 
-	// Close files
-	trueFile.close();
-	classFile.close();
-
 }
 
 
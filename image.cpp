@@ -14,11 +14,16 @@
 // Libraries
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 using namespace std;
 
 #include "image.h"
 #include "rgb.h"
+#include "MemoryStats.h"
+#include "Parallel.h"
+
+#define FIRST_TOUCH_PIXELS 65536   // Smaller images are allocated by the caller.
 
 
 // Functions
@@ -46,18 +51,22 @@ ImageType::ImageType()
  */
 ImageType::ImageType(int tmpN, int tmpM, int tmpQ)
 {
- int i, j;
-
  N = tmpN;
  M = tmpM;
  Q = tmpQ;
 
+ // Large images get their rows from the bands that will process them,
+ // so each row's pages are first touched on that band's node
  pixelValue = new int* [N];
- for(i=0; i<N; i++) {
-   pixelValue[i] = new int[M*3];
-   for(j=0; j<M; j++)
-     pixelValue[i][j] = 0;
- }
+ parallelFor(N, imageBands(N, M), [&](int begin, int end) {
+   for(int i=begin; i<end; i++) {
+     pixelValue[i] = new int[M*3];
+     for(int j=0; j<M*3; j++)
+       pixelValue[i][j] = 0;
+   }
+ });
+
+ trackAlloc(MEMORY_IMAGE, (size_t)N*(sizeof(int*) + 3*M*sizeof(int)));
 }
 
 
@@ -68,6 +77,8 @@ ImageType::~ImageType() {
  for(int i = 0; i < N; i++) {
 	delete[] pixelValue[i];
  }
+ if(pixelValue != NULL)
+	trackFree(MEMORY_IMAGE, (size_t)N*(sizeof(int*) + 3*M*sizeof(int)));
  delete[] pixelValue;
 }
 
@@ -175,6 +186,20 @@ void ImageType::getPixelVal(int i, int j, RGB& val)
 }
 
 
+/* getRow():
+ * 	Gets the storage holding one row of pixel values. RGB images
+ * 	keep three values per pixel, interleaved as r, g, b.
+ * args:
+ * 	@i: The row to access.
+ * return:
+ * 	int*: The first pixel value of the row.
+ */
+int* ImageType::getRow(int i)
+{
+ return pixelValue[i];
+}
+
+
 /* operator=():
  * 	Modifies the left-hand object (self) by reassigning its values
  * 	to match that of the right-hand object.
@@ -184,26 +209,46 @@ void ImageType::getPixelVal(int i, int j, RGB& val)
  * 	(*)this
  */
 ImageType& ImageType::operator=(ImageType& image) {
+	if(this == &image) {
+		return *this;
+	}
+
 	// Remove old pixel values
 	for(int i = 0; i < N; i++) {
 		delete[] pixelValue[i];
 	}
-	if(pixelValue != NULL)
+	if(pixelValue != NULL) {
+		trackFree(MEMORY_IMAGE, (size_t)N*(sizeof(int*) + 3*M*sizeof(int)));
 		delete[] pixelValue;
+	}
 
 	// Reassign basic variables
 	image.getImageInfo(N, M, Q);
 
 	// Allocate and store new pixel values
 	pixelValue = new int*[N];
-	for(int i = 0; i < N; i++) {
-		pixelValue[i] = new int[M*3];
-		for(int j = 0; j < M; j++) {
-			int val;
-			image.getPixelVal(i, j, val);
-			pixelValue[i][j] = val;
+	trackAlloc(MEMORY_IMAGE, (size_t)N*(sizeof(int*) + 3*M*sizeof(int)));
+	parallelFor(N, imageBands(N, M), [&](int begin, int end) {
+		for(int i = begin; i < end; i++) {
+			pixelValue[i] = new int[M*3];
+			memcpy(pixelValue[i], image.getRow(i), M*3*sizeof(int));
 		}
-	}
+	});
 
 	return *this;
 }
+
+
+/* imageBands():
+ * 	Gets the number of bands an image's rows are allocated in. Loops
+ * 	that pass this to parallelFor() read each row on the node that
+ * 	first touched it.
+ * args:
+ * 	@rows: The number of rows.
+ * 	@cols: The number of columns.
+ * return:
+ * 	int: 1 for small images; 0 (the default count) otherwise.
+ */
+int imageBands(int rows, int cols) {
+	return (long)rows*cols < FIRST_TOUCH_PIXELS ? 1 : 0;
+}
@@ -28,12 +28,15 @@ class ImageType {
    void setPixelVal(int, int, RGB&);
    void getPixelVal(int, int, int&);
    void getPixelVal(int, int, RGB&);
+   int* getRow(int);
    ImageType& operator=(ImageType&);
  private:
    int N, M, Q;       // N: Rows; M: Columns; Q: Max. pixel value;
    int **pixelValue;  // pixelValue: List of pixel values.
 };
 
+int imageBands(int, int);
+
 #include "image.cpp"
 
 #endif
@@ -1,6 +1,13 @@
 // Libraries
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/stat.h>
 
 #include "classification.hpp"
 #include "ReadImage.h"
@@ -8,6 +15,21 @@
 #include "WriteImage.h"
 #include "CreateModel.h"
 #include "ClassifySkin.h"
+#include "Pipeline.h"
+#include "SkinModel.h"
+#include "SkinServer.h"
+#include "FixedPoint.h"
+#include "FrameStream.h"
+#include "ModelStats.h"
+#include "ScoreMap.h"
+#include "MemoryStats.h"
+#include "ModelEval.h"
+#include "CrossValidate.h"
+#include "LearningCurve.h"
+#include "HistogramModel.h"
+#include "BitMask.h"
+#include "ImageCache.h"
+#include "RunMask.h"
 #include "image.h"
 
 
@@ -64,16 +86,30 @@ void basicCopyPaste() {
 
 }
 
-void genModel(bool isRGB = true) {
-	std::cout << "Learning from " << REF_PPM_1 << std::endl;
-	
-	if (isRGB) {
-		learnForModel((char*)TRN_PPM_1, (char*)REF_PPM_1, (char*)MOD_OUT, isRGB);
+// Gets the statistics of the experiment's training images, gathered once
+const ImageStats& experimentStats() {
+	static ImageStats stats;
+	static bool ready = false;
+
+	if(!ready) {
+		char* train[] = { (char*)TRN_PPM_1 };
+		char* ref[] = { (char*)REF_PPM_1 };
+		std::cout << "Learning from " << REF_PPM_1 << std::endl;
+		statsForImagePairs(train, ref, 1, stats);
+		ready = true;
 	}
-	else {
-		learnForModel((char*)TRN_PPM_1, (char*)REF_PPM_1, (char*)MOD_YCC, isRGB);
+	return stats;
+}
+
+void genModel() {
+	SkinModel model;
+
+	// One pass over the images gives both colour schemes
+	for(int isRGB = 1; isRGB >= 0; isRGB--) {
+		defaultSkinModel(isRGB, model);
+		modelForStats(experimentStats(), isRGB, model.t, model);
+		saveSkinModel((char*)(isRGB ? MOD_OUT : MOD_YCC), model);
 	}
-	
 }
 
 void testClassifyPixel() {
@@ -89,23 +125,9 @@ void testClassifyPixel() {
 
 void calculatePriors() {
 	float skinPrior;
-	int skinCount, totalCount, tmpSkin, tmpTotal;
-	skinCount = 0;
-	totalCount = 0;
-
-	estimatePriors((char*)REF_PPM_1, tmpSkin, tmpTotal);
-	skinCount += tmpSkin;
-	totalCount += tmpTotal;
-
-	/*estimatePriors((char*)REF_PPM_2, tmpSkin, tmpTotal);
-        skinCount += tmpSkin;
-        totalCount += tmpTotal;
+	long totalCount = experimentStats().totalCount;
 
-	estimatePriors((char*)REF_PPM_3, tmpSkin, tmpTotal);
-        skinCount += tmpSkin;
-        totalCount += tmpTotal;*/
-
-	skinPrior = (float)skinCount / totalCount;
+	skinPrior = (float)experimentStats().skinCount / totalCount;
 
 	std::cout << std::endl << "Prior Values:" << std::endl;
 	std::cout << "==========================" << std::endl;
@@ -123,7 +145,7 @@ void testSkinClassification(char* inFile, char* outFile, bool isRGB, float t) {
 
 	classifyForImage(image, outImage, t, isRGB);
 
-	writeImagePPM(outFile, outImage);
+	writeImageParallel(outFile, outImage, true);
 }
 
 void testSkinMisclassification(float& fpRate, float& fnRate, float t, bool isRGB) {
@@ -155,124 +177,98 @@ void testSkinMisclassification(float& fpRate, float& fnRate, float t, bool isRGB
 	std::cout << "False negative rate:  " << fnRate << std::endl;
 }
 
-void getROCVals(bool isRGB) {
-	char* fName;
-	float fpRate, fnRate, minT, maxT, stride;
-	int fp = 0, fn = 0, totalPix = 0;
-	int fpTmp, fnTmp;
-	int rows, cols, levels;
-	ImageType image, refImage, outImage;
+void getROCVals() {
+	const char* fNames[2] = { "roc_ycc.txt", "roc.txt" };
+	float minT[2], maxT[2], stride[2];
+	long totalPix = 0;
+	char* trainFiles[2] = { (char*)TRN_PPM_2, (char*)TRN_PPM_3 };
+	char* refFiles[2] = { (char*)REF_PPM_2, (char*)REF_PPM_3 };
+	std::vector<ModelEvaluation> evals(2);
 
-	// Configure for RGB
-	if (isRGB) {
-		fName = (char*)"roc.txt";
-		minT = 0.00000;
-		maxT = 7.46400;		// Max prob value = 7.10792; adust for 21 iters
-		stride = 7.10792 / 20;
-	}
 	// Configure for YCrCb
-	else {
-		fName = (char*)"roc_ycc.txt";
-		minT = -4.53314 * 2;		// Translate to match [0,maxT]
-		maxT = -4.29900;		// Max prob value = -4.53314; adjust for 21 iters
-		stride = 4.53314 / 20;
-	}
-
-	// Open file
-	std::ofstream outFile(fName);
+	minT[0] = -4.53314 * 2;		// Translate to match [0,maxT]
+	maxT[0] = -4.29900;		// Max prob value = -4.53314; adjust for 21 iters
+	stride[0] = 4.53314 / 20;
 
-	// Test for inproper file access
-	if(!outFile.is_open()) {
-		std::cout << "Could not open file roc.txt" << std::endl;
-		exit(1);
+	// Configure for RGB
+	minT[1] = 0.00000;
+	maxT[1] = 7.46400;		// Max prob value = 7.10792; adust for 21 iters
+	stride[1] = 7.10792 / 20;
+
+	// Every threshold of both models is counted in one pass per image
+	for(int isRGB = 0; isRGB < 2; isRGB++) {
+		SkinModel model;
+		std::vector<float> thresholds;
+		for(float i = minT[isRGB]; i <= maxT[isRGB]; i += stride[isRGB]) {
+			thresholds.push_back(i);
+		}
+		defaultSkinModel(isRGB, model);
+		prepareModelEvaluation(model, thresholds, evals[isRGB]);
 	}
 
-	// Start ROC processes
-	int iter = 1;
-	for(float i = minT; i <= maxT; i += stride, iter++) {
-		std::cout << "(" << iter << "/20)" << std::endl;
-
-		// Redefine variables
-		totalPix = 0;
-		fn = 0;
-		fp = 0;
+	for(int k = 0; k < 2; k++) {
+		ImageType image, refImage;
+		int rows, cols, levels;
 
-		// Test on first image
-		getImage((char*)TRN_PPM_2, image);
-		outImage = image;
-		getImage((char*)REF_PPM_2, refImage);
+		std::cout << "(" << k + 1 << "/2)" << std::endl;
+		getImage(trainFiles[k], image);
+		getImage(refFiles[k], refImage);
+		evaluateModels(image, &refImage, evals);
 
-		classifyForImage(image, outImage, i, isRGB);
-
-		getMisclass(outImage, refImage, fpTmp, fnTmp);
-		
-		outImage.getImageInfo(rows, cols, levels);
+		image.getImageInfo(rows, cols, levels);
 		totalPix += rows * cols;
-		fp += fpTmp;
-		fn += fnTmp;
-
-		// Test on second image
-		getImage((char*)TRN_PPM_3, image);
-		outImage = image;
-		getImage((char*)REF_PPM_3, refImage);
-
-		classifyForImage(image, outImage, i, isRGB);
-
-		getMisclass(outImage, refImage, fp, fn);
-		
-		outImage.getImageInfo(rows, cols, levels);
-		totalPix += rows * cols;
-		fp += fpTmp;
-		fn += fnTmp;
-
-		// Calculate misclassification rates
-		fpRate = (float)fp / totalPix;
-		fnRate = (float)fn / totalPix;
-		outFile << i << "," << fpRate << "," << fnRate << std::endl;
 	}
 
-	outFile.close();
+	// Write misclassification rates
+	for(int isRGB = 0; isRGB < 2; isRGB++) {
+		std::ofstream outFile(fNames[isRGB]);
+
+		// Test for inproper file access
+		if(!outFile.is_open()) {
+			std::cout << "Could not open file " << fNames[isRGB] << std::endl;
+			exit(1);
+		}
+
+		for(size_t k = 0; k < evals[isRGB].thresholds.size(); k++) {
+			const ConfusionMatrix& counts = evals[isRGB].counts[k];
+			outFile << evals[isRGB].thresholds[k] << ","
+				<< (float)counts.fp / totalPix << ","
+				<< (float)counts.fn / totalPix << std::endl;
+		}
+		outFile.close();
+	}
 }
 
-void calculateMeans(char fName[]) {
-	float mur, mug;
-	estimateRGMean((char*)fName, mur, mug);
+void calculateMeans(bool isRGB) {
+	float mu[2], cov[2][2];
+	meanCovForStats(experimentStats().skin[isRGB], mu, cov);
 
 	std::cout << std::endl << "Mean values:" << std::endl;
 	std::cout << "=========================" << std::endl;
-	std::cout << "r mean: " << mur << std::endl;
-	std::cout << "g mean: " << mug << std::endl;
+	std::cout << "r mean: " << mu[0] << std::endl;
+	std::cout << "g mean: " << mu[1] << std::endl;
 }
 
-void calculateCov(char fName[]) {
-	float mur, mug, covrr, covgg, covrg;
+void calculateCov(bool isRGB) {
+	float mu[2], cov[2][2];
 
-	// Get sample means
-	estimateRGMean((char*)fName, mur, mug);
-	
-	// Calculate covariances
-	estimateCovarianceRG((char*)fName, covrr, covgg, covrg, mur, mug);
+	// Get sample means and covariances
+	meanCovForStats(experimentStats().skin[isRGB], mu, cov);
 
 	// Display results
 	std::cout << std::endl << "Covariance Values" << std::endl;
 	std::cout << "==============================" << std::endl;
-	std::cout << "COV(R,G) = " << covrg << std::endl;
-	std::cout << "COV(R,R) = " << covrr << std::endl;
-	std::cout << "COV(G,G) = " << covgg << std::endl;
+	std::cout << "COV(R,G) = " << cov[0][1] << std::endl;
+	std::cout << "COV(R,R) = " << cov[0][0] << std::endl;
+	std::cout << "COV(G,G) = " << cov[1][1] << std::endl;
 }
 
 
 void runParameterEstimation(bool isRGB) {
-	if (isRGB) {
-		calculatePriors();
-		calculateMeans((char*)MOD_OUT);
-		calculateCov((char*)MOD_OUT);
-	}
-	else {
-		calculatePriors();
-                calculateMeans((char*)MOD_YCC);
-                calculateCov((char*)MOD_YCC);
-	}
+	// Every statistic comes from the same single pass over the images
+	calculatePriors();
+	calculateMeans(isRGB);
+	calculateCov(isRGB);
 }
 
 void runClassifyERR(bool isRGB) {
@@ -289,10 +285,32 @@ void runClassifyERR(bool isRGB) {
 }
 
 void genERRTests() {
-	testSkinClassification((char*)TRN_PPM_2, (char*)"Classified_RGB_2.ppm", true, 6.75252);
-	testSkinClassification((char*)TRN_PPM_3, (char*)"Classified_RGB_3.ppm", true, 6.75252);
-	testSkinClassification((char*)TRN_PPM_2, (char*)"Classified_YCC_2.ppm", false, -5.21311);
-        testSkinClassification((char*)TRN_PPM_3, (char*)"Classified_YCC_3.ppm", false, -5.21311);
+	char* inFiles[2] = { (char*)TRN_PPM_2, (char*)TRN_PPM_3 };
+	char* rgbFiles[2] = { (char*)"Classified_RGB_2.ppm", (char*)"Classified_RGB_3.ppm" };
+	char* yccFiles[2] = { (char*)"Classified_YCC_2.ppm", (char*)"Classified_YCC_3.ppm" };
+	std::vector<ModelEvaluation> evals(2);
+	SkinModel model;
+
+	defaultSkinModel(true, model);
+	prepareModelEvaluation(model, std::vector<float>(), evals[0]);
+	defaultSkinModel(false, model);
+	prepareModelEvaluation(model, std::vector<float>(), evals[1]);
+
+	// Both masks of an image come from one pass over it
+	for(int k = 0; k < 2; k++) {
+		ImageType image;
+		int rows, cols, levels;
+
+		getImage(inFiles[k], image);
+		image.getImageInfo(rows, cols, levels);
+		ImageType rgbMask(rows, cols, levels), yccMask(rows, cols, levels);
+		evals[0].mask = &rgbMask;
+		evals[1].mask = &yccMask;
+
+		evaluateModels(image, NULL, evals);
+		writeImageParallel(rgbFiles[k], rgbMask, true);
+		writeImageParallel(yccFiles[k], yccMask, true);
+	}
 }
 
 void genPartitions(int i) {
@@ -423,9 +441,6 @@ void experiment3() {
 	///// A /////
 	// Build model
 	runParameterEstimation(true);
-
-	// Generate ROC values
-	//getROCVals(true);
 	
 	std::cout << "\n=======================" << std::endl;
         std::cout << "Experiment 3B" << std::endl;
@@ -434,16 +449,1179 @@ void experiment3() {
 	// Build model
 	runParameterEstimation(false);
 	
-	// Generate ROC values
-	//getROCVals(false);
+	// Generate ROC values for 3A and 3B together
+	//getROCVals();
 	
 	// Generate classified images with ERR
 	genERRTests();
 }
 
-int main(int argc, char** argv) {
+void printUsage() {
+	std::cout << "Usage:" << std::endl;
+	std::cout << "  main                                  Run the project experiments" << std::endl;
+	std::cout << "  main export-model <rgb|ycc> <model>   Save the experiment model to a file" << std::endl;
+	std::cout << "  main export-header <out.h> <name> <model> [<name> <model>]..." << std::endl;
+	std::cout << "                                        Save models as compile-time constants" << std::endl;
+	std::cout << "  main batch <model> [options] <ppm|dir>..." << std::endl;
+	std::cout << "      -o <dir>       Directory for classified images (default .)" << std::endl;
+	std::cout << "      -t <t>         Override the model threshold" << std::endl;
+	std::cout << "      -depth <n>     Images held between pipeline stages" << std::endl;
+	std::cout << "      -budget <MiB>  Max memory for images in flight" << std::endl;
+	std::cout << "      -fixed         Classify with integer arithmetic only" << std::endl;
+	std::cout << "      -blocks <n>    Decide uniform n x n blocks at once" << std::endl;
+	std::cout << "  main serve <model> <socket> [-workers n] [-batch n]" << std::endl;
+	std::cout << "  main client <socket> <in.ppm> <out.ppm> [-repeat n]" << std::endl;
+	std::cout << "  main fixed-check <model>              Compare integer and float classifiers" << std::endl;
+	std::cout << "  main stream <model> <in|-> [options]  Classify PPM or Y4M frames from a file or pipe" << std::endl;
+	std::cout << "      -o <file|->    Write the masks as back-to-back PGM frames" << std::endl;
+	std::cout << "      -tile <n>      Width and height of reused tiles (default 16)" << std::endl;
+	std::cout << "      -tol <n>       Largest channel change that keeps a tile (default 0)" << std::endl;
+	std::cout << "      -erode|-dilate|-open|-close <r>, -min <n>" << std::endl;
+	std::cout << "                     Clean each mask before writing, in the order given" << std::endl;
+	std::cout << "  main stats-add <ckpt> <train.ppm> <ref.ppm> [<train.ppm> <ref.ppm>]..." << std::endl;
+	std::cout << "                                        Fold image pairs into a statistics checkpoint" << std::endl;
+	std::cout << "  main stats-remove <ckpt> <train.ppm>...  Take image pairs back out" << std::endl;
+	std::cout << "  main stats-model <ckpt> <rgb|ycc> <model> [-t t]" << std::endl;
+	std::cout << "                                        Build a model from a checkpoint" << std::endl;
+	std::cout << "  main score <model> <in.ppm> <out.scores> [-lo s] [-hi s]" << std::endl;
+	std::cout << "                                        Save every pixel's score for rethresholding" << std::endl;
+	std::cout << "  main threshold <scores> <t>... [-o mask.pgm] [-ref ref.ppm]" << std::endl;
+	std::cout << "                                        Mask (first t) or FP/FN counts (every t)" << std::endl;
+	std::cout << "  main evaluate -m <model> [-m <model>]... [-t t]... <train.ppm> <ref.ppm>..." << std::endl;
+	std::cout << "                                        Compare models in one pass per image" << std::endl;
+	std::cout << "  main cv-points <data.txt> [-k n] [-seed s]" << std::endl;
+	std::cout << "                                        Cross-validate the Gaussian classifier on points" << std::endl;
+	std::cout << "  main cv-images [-k n] [-t-rgb t] [-t-ycc t] <train.ppm> <ref.ppm>..." << std::endl;
+	std::cout << "                                        Cross-validate both skin models on image pairs" << std::endl;
+	std::cout << "  main curve <data.txt> [-f portion]... [-reps n] [-seed s]" << std::endl;
+	std::cout << "                                        Error against sample size (default 0.01%-10%)" << std::endl;
+	std::cout << "  main classify-points <train.txt> <test.txt> <out.txt> [-grid n]" << std::endl;
+	std::cout << "                                        Gaussian classifier of experiment 2, n x n grid" << std::endl;
+	std::cout << "  main hist-train <model.hist> <rgb3|rg|cbcr> <bins> <train.ppm> <ref.ppm>... [-t t]" << std::endl;
+	std::cout << "                                        Build a colour histogram skin model" << std::endl;
+	std::cout << "  main hist-classify <model.hist> <in.ppm> <out.ppm> [-t t] [-ref ref.ppm]" << std::endl;
+	std::cout << "                                        Classify with a histogram model" << std::endl;
+	std::cout << "  main clean <mask.ppm> <out.ppm> [-erode r|-dilate r|-open r|-close r|-min n]..." << std::endl;
+	std::cout << "                                        Clean a mask, steps applied in order" << std::endl;
+	std::cout << "  main rle-classify <model> <in.ppm> <out.rle> [-ref ref.ppm]" << std::endl;
+	std::cout << "                                        Classify straight to a run-length mask" << std::endl;
+	std::cout << "  main rle-pack <mask.ppm> <out.rle>    Convert a mask image to runs" << std::endl;
+	std::cout << "  main rle-expand <in.rle> <out.ppm>    Convert runs to a mask image" << std::endl;
+	std::cout << "  main rle-misclass <mask.rle> <ref.ppm|ref.rle>" << std::endl;
+	std::cout << "                                        FP/FN counts from the runs" << std::endl;
+	std::cout << "Set SKIN_MEMORY=1 to report memory use when the run ends." << std::endl;
+}
+
+// Adds the PPM files named by a path (a file, or every .ppm in a directory)
+void listBatchImages(const std::string& path, std::vector<std::string>& files) {
+	struct stat info;
+	if(stat(path.c_str(), &info) != 0) {
+		std::cout << "Error: Could not access " << path << std::endl;
+		exit(1);
+	}
+
+	if(!S_ISDIR(info.st_mode)) {
+		files.push_back(path);
+		return;
+	}
+
+	DIR* dir = opendir(path.c_str());
+	if(dir == NULL) {
+		std::cout << "Error: Could not open directory " << path << std::endl;
+		exit(1);
+	}
+
+	std::vector<std::string> found;
+	struct dirent* entry;
+	while((entry = readdir(dir)) != NULL) {
+		std::string name = entry->d_name;
+		if(name.size() > 4 && name.compare(name.size() - 4, 4, ".ppm") == 0) {
+			found.push_back(path + "/" + name);
+		}
+	}
+	closedir(dir);
+
+	std::sort(found.begin(), found.end());
+	files.insert(files.end(), found.begin(), found.end());
+}
+
+// Gets the latency at a percentile from sorted latencies
+double percentile(const std::vector<double>& sorted, double p) {
+	size_t k = (size_t)(p / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[k];
+}
+
+int runExportModel(int argc, char** argv) {
+	if(argc != 2) {
+		printUsage();
+		return 1;
+	}
+
+	SkinModel model;
+	defaultSkinModel(std::string(argv[0]) != "ycc", model);
+	saveSkinModel(argv[1], model);
+	return 0;
+}
+
+int runExportHeader(int argc, char** argv) {
+	if(argc < 3 || argc % 2 != 1) {
+		printUsage();
+		return 1;
+	}
+
+	int count = (argc - 1) / 2;
+	std::vector<SkinModel> models(count);
+	std::vector<char*> names(count);
+	for(int k = 0; k < count; k++) {
+		names[k] = argv[1 + k * 2];
+		loadSkinModel(argv[2 + k * 2], models[k]);
+	}
+
+	exportSkinModelHeader(argv[0], models.data(), names.data(), count);
+	return 0;
+}
+
+int runBatch(int argc, char** argv) {
+	SkinModel model;
+	FixedSkinModel fixed;
+	bool useFixed = false;
+	int blockSize = 0;
+	PipelineOptions opts = defaultPipelineOptions();
+	std::string outDir = ".";
+	std::vector<std::string> files;
+
+	if(argc < 2) {
+		printUsage();
+		return 1;
+	}
+
+	// Load model once for the whole batch
+	loadSkinModel(argv[0], model);
+
+	// Read options and inputs
+	for(int k = 1; k < argc; k++) {
+		std::string arg = argv[k];
+		if(arg == "-o" && k + 1 < argc) {
+			outDir = argv[++k];
+		}
+		else if(arg == "-t" && k + 1 < argc) {
+			model.t = atof(argv[++k]);
+		}
+		else if(arg == "-depth" && k + 1 < argc) {
+			opts.depth = atoi(argv[++k]);
+		}
+		else if(arg == "-budget" && k + 1 < argc) {
+			opts.memoryBudget = (size_t)atol(argv[++k]) << 20;
+		}
+		else if(arg == "-fixed") {
+			useFixed = true;
+		}
+		else if(arg == "-blocks" && k + 1 < argc) {
+			blockSize = atoi(argv[++k]);
+		}
+		else {
+			listBatchImages(arg, files);
+		}
+	}
+
+	if(files.empty()) {
+		std::cout << "No images to classify" << std::endl;
+		return 1;
+	}
+
+	prepareFixedSkinModel(model, fixed);
+
+	// Build jobs
+	std::vector<PipelineJob> jobs(files.size());
+	for(size_t k = 0; k < files.size(); k++) {
+		std::string name = files[k].substr(files[k].find_last_of('/') + 1);
+		jobs[k].inFile = files[k];
+		jobs[k].outFile = outDir + "/" + name.substr(0, name.size() - 4) + "_skin.ppm";
+		jobs[k].isRGB = model.isRGB;
+		jobs[k].t = model.t;
+		jobs[k].model = &model;
+		jobs[k].fixedModel = useFixed ? &fixed : NULL;
+		jobs[k].blockSize = blockSize;
+	}
+
+	// Classify
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	runPipeline(jobs, opts);
+	double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	// Report throughput
+	std::vector<double> latency, wait;
+	long pixels = 0;
+	for(size_t k = 0; k < jobs.size(); k++) {
+		latency.push_back(jobs[k].seconds * 1000.0);
+		wait.push_back(jobs[k].waitSeconds * 1000.0);
+		pixels += jobs[k].pixels;
+	}
+	std::sort(latency.begin(), latency.end());
+	std::sort(wait.begin(), wait.end());
+
+	std::cout << std::endl << "Batch Summary" << std::endl;
+	std::cout << "==============================" << std::endl;
+	std::cout << "Images classified:  " << jobs.size() << std::endl;
+	std::cout << "Pixels classified:  " << pixels << std::endl;
+	std::cout << "Wall time (s):      " << wall << std::endl;
+	std::cout << "Pixels per second:  " << (wall > 0 ? pixels / wall : 0) << std::endl;
+	std::cout << "Latency p50 (ms):   " << percentile(latency, 50) << std::endl;
+	std::cout << "Latency p90 (ms):   " << percentile(latency, 90) << std::endl;
+	std::cout << "Latency p99 (ms):   " << percentile(latency, 99) << std::endl;
+	std::cout << "Latency max (ms):   " << latency.back() << std::endl;
+	std::cout << "Waiting p50 (ms):   " << percentile(wait, 50) << std::endl;
+	std::cout << "Waiting p99 (ms):   " << percentile(wait, 99) << std::endl;
+
+	return 0;
+}
+
+int runFixedCheck(int argc, char** argv) {
+	SkinModel model;
+	FixedSkinModel fixed;
+	long disagree;
+	float maxGap;
+
+	if(argc != 1) {
+		printUsage();
+		return 1;
+	}
+
+	loadSkinModel(argv[0], model);
+	prepareFixedSkinModel(model, fixed);
+	compareFixedSkinModel(model, fixed, disagree, maxGap);
+
+	std::cout << std::endl << "Fixed-point vs float (t = " << model.t << ")" << std::endl;
+	std::cout << "==============================" << std::endl;
+	std::cout << "Colours tested:     " << (1L << 24) << std::endl;
+	std::cout << "Colours differing:  " << disagree << std::endl;
+	std::cout << "Max |score - t|:    " << maxGap << std::endl;
+	return 0;
+}
+
+void handleStopSignal(int) {
+	stopSkinServer();
+}
+
+int runServe(int argc, char** argv) {
+	SkinModel model;
+	int workers = 0, maxBatch = 8;
+	struct sigaction action;
+
+	if(argc < 2) {
+		printUsage();
+		return 1;
+	}
+
+	loadSkinModel(argv[0], model);
+	for(int k = 2; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-workers") {
+			workers = atoi(argv[k + 1]);
+		}
+		else if(arg == "-batch") {
+			maxBatch = atoi(argv[k + 1]);
+		}
+	}
+
+	// Stop cleanly on interrupt
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = handleStopSignal;
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+
+	std::cout << "Serving on " << argv[1] << std::endl;
+	runSkinServer(argv[1], model, workers, maxBatch);
+	return 0;
+}
+
+int runClient(int argc, char** argv) {
+	ImageType image;
+	int rows, cols, levels, repeat = 1;
+
+	if(argc < 3) {
+		printUsage();
+		return 1;
+	}
+	if(argc == 5 && std::string(argv[3]) == "-repeat") {
+		repeat = atoi(argv[4]);
+	}
+	if(repeat < 1) {
+		std::cout << "Error: -repeat must be at least 1" << std::endl;
+		return 1;
+	}
+
+	getImage(argv[1], image);
+	image.getImageInfo(rows, cols, levels);
+	ImageType mask(rows, cols, levels);
+
+	// Time round trips to the server
+	std::vector<double> latency;
+	for(int k = 0; k < repeat; k++) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		classifyRemote(argv[0], image, mask);
+		latency.push_back(std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count() * 1000.0);
+	}
+	std::sort(latency.begin(), latency.end());
+
+	writeImagePPM(argv[2], mask);
+
+	std::cout << "Round trips:        " << repeat << std::endl;
+	std::cout << "Latency p50 (ms):   " << percentile(latency, 50) << std::endl;
+	std::cout << "Latency p99 (ms):   " << percentile(latency, 99) << std::endl;
+	return 0;
+}
+
+// Tests whether a flag names a mask cleaning step
+bool isCleanStep(const std::string& step) {
+	return step == "-erode" || step == "-dilate" || step == "-open" || step == "-close" || step == "-min";
+}
+
+// Applies one cleaning step to a mask; returns the regions removed by -min
+long applyCleanStep(const std::string& step, int val, BitMask& mask) {
+	if(step == "-erode") {
+		erodeMask(mask, val);
+	}
+	else if(step == "-dilate") {
+		dilateMask(mask, val);
+	}
+	else if(step == "-open") {
+		openMask(mask, val);
+	}
+	else if(step == "-close") {
+		closeMask(mask, val);
+	}
+	else if(step == "-min") {
+		return removeSmallComponents(mask, val);
+	}
+	return 0;
+}
+
+int runStream(int argc, char** argv) {
+	SkinModel model;
+	SkinPrefilter filter;
+	FrameReader reader;
+	StreamFrame frame;
+	TemporalState state;
+	BitMask cleanMask;
+	std::vector<std::pair<std::string, int> > steps;
+	std::vector<unsigned char> cleaned;
+	int tile = 16, tolerance = 0;
+	std::string outFile;
+	FILE* out = NULL;
+
+	if(argc < 2) {
+		printUsage();
+		return 1;
+	}
+
+	loadSkinModel(argv[0], model);
+	for(int k = 2; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-o") {
+			outFile = argv[k + 1];
+		}
+		else if(arg == "-tile") {
+			tile = atoi(argv[k + 1]);
+		}
+		else if(arg == "-tol") {
+			tolerance = atoi(argv[k + 1]);
+		}
+		else if(isCleanStep(arg)) {
+			steps.push_back(std::make_pair(arg, atoi(argv[k + 1])));
+		}
+	}
+
+	if(!outFile.empty()) {
+		out = outFile == "-" ? stdout : fopen(outFile.c_str(), "wb");
+		if(out == NULL) {
+			std::cout << "Error: Could not open " << outFile << std::endl;
+			return 1;
+		}
+	}
+
+	prepareSkinPrefilter(model, filter);
+	prepareTemporalState(tile, tolerance, state);
+	openFrameStream(argv[1], reader);
+
+	// Classify frames as they arrive
+	std::vector<double> latency;
+	long pixels = 0;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while(readFrame(reader, frame)) {
+		std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+		classifyFrameTemporal(frame, model, filter, state);
+		const unsigned char* mask = state.mask.data();
+
+		// Clean a copy so tile reuse keeps comparing against raw decisions
+		if(!steps.empty()) {
+			maskFromBytes(mask, frame.rows, frame.cols, cleanMask);
+			for(size_t k = 0; k < steps.size(); k++) {
+				applyCleanStep(steps[k].first, steps[k].second, cleanMask);
+			}
+			cleaned.resize((size_t)frame.rows * frame.cols);
+			bytesFromMask(cleanMask, cleaned.data());
+			mask = cleaned.data();
+		}
+		latency.push_back(std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - frameStart).count() * 1000.0);
+		pixels += (long)frame.rows * frame.cols;
+
+		if(out != NULL) {
+			writeMaskFrame(out, frame.rows, frame.cols, mask);
+		}
+	}
+	double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	closeFrameStream(reader);
+	if(out != NULL && out != stdout) {
+		fclose(out);
+	}
+	else if(out == stdout) {
+		fflush(stdout);
+	}
+
+	if(latency.empty()) {
+		std::cerr << "No frames in stream" << std::endl;
+		return 1;
+	}
+	std::sort(latency.begin(), latency.end());
+
+	// Keep the report off stdout when masks are written there
+	std::ostream& report = out == stdout ? std::cerr : std::cout;
+	long tiles = state.tilesReused + state.tilesClassified;
+	report << std::endl << "Stream Summary" << std::endl;
+	report << "==============================" << std::endl;
+	report << "Frames classified:  " << latency.size() << std::endl;
+	report << "Pixels per second:  " << (wall > 0 ? pixels / wall : 0) << std::endl;
+	report << "Tiles reused (%):   " << (tiles > 0 ? 100.0 * state.tilesReused / tiles : 0) << std::endl;
+	report << "Latency p50 (ms):   " << percentile(latency, 50) << std::endl;
+	report << "Latency p99 (ms):   " << percentile(latency, 99) << std::endl;
+	report << "Latency max (ms):   " << latency.back() << std::endl;
+	return 0;
+}
+
+int runStatsAdd(int argc, char** argv) {
+	StatsCheckpoint checkpoint;
+
+	if(argc < 3 || argc % 2 != 1) {
+		printUsage();
+		return 1;
+	}
+
+	loadStatsCheckpoint(argv[0], checkpoint);
+	for(int k = 1; k + 1 < argc; k += 2) {
+		addCheckpointImage(checkpoint, argv[k], argv[k + 1]);
+	}
+	saveStatsCheckpoint(argv[0], checkpoint);
+
+	std::cout << "Images in checkpoint: " << checkpoint.images.size() << std::endl;
+	std::cout << "Skin pixels:          " << checkpoint.total.skinCount << std::endl;
+	std::cout << "Total pixels:         " << checkpoint.total.totalCount << std::endl;
+	return 0;
+}
+
+int runStatsRemove(int argc, char** argv) {
+	StatsCheckpoint checkpoint;
+
+	if(argc < 2) {
+		printUsage();
+		return 1;
+	}
+
+	if(!loadStatsCheckpoint(argv[0], checkpoint)) {
+		std::cout << "Error: Could not open " << argv[0] << std::endl;
+		return 1;
+	}
+	for(int k = 1; k < argc; k++) {
+		if(!removeCheckpointImage(checkpoint, argv[k])) {
+			std::cout << "Error: " << argv[k] << " is not in the checkpoint" << std::endl;
+			return 1;
+		}
+	}
+	saveStatsCheckpoint(argv[0], checkpoint);
+
+	std::cout << "Images in checkpoint: " << checkpoint.images.size() << std::endl;
+	return 0;
+}
+
+int runStatsModel(int argc, char** argv) {
+	StatsCheckpoint checkpoint;
+	SkinModel model;
+
+	if(argc != 3 && argc != 5) {
+		printUsage();
+		return 1;
+	}
+
+	bool isRGB = std::string(argv[1]) != "ycc";
+	if(!loadStatsCheckpoint(argv[0], checkpoint)) {
+		std::cout << "Error: Could not open " << argv[0] << std::endl;
+		return 1;
+	}
+
+	// Keep the experiment threshold unless one is given
+	defaultSkinModel(isRGB, model);
+	float t = argc == 5 && std::string(argv[3]) == "-t" ? atof(argv[4]) : model.t;
+
+	modelForStats(checkpoint.total, isRGB, t, model);
+	saveSkinModel(argv[2], model);
+
+	std::cout << "Prior:  " << model.prior << std::endl;
+	std::cout << "Mean:   " << model.mu[0] << " " << model.mu[1] << std::endl;
+	std::cout << "Cov:    " << model.cov[0][0] << " " << model.cov[0][1] << " "
+		<< model.cov[1][1] << std::endl;
+	return 0;
+}
+
+int runScore(int argc, char** argv) {
+	SkinModel model;
+	ImageType image;
+	ScoreMap map;
+	float lo, hi;
+
+	if(argc < 3) {
+		printUsage();
+		return 1;
+	}
+
+	loadSkinModel(argv[0], model);
+	defaultScoreRange(model, lo, hi);
+	for(int k = 3; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-lo") {
+			lo = atof(argv[k + 1]);
+		}
+		else if(arg == "-hi") {
+			hi = atof(argv[k + 1]);
+		}
+	}
+
+	getImage(argv[1], image);
+	scoreMapForImage(image, model, lo, hi, map);
+	saveScoreMap(argv[2], map);
+	closeScoreMap(map);
+
+	std::cout << "Score range:        [" << lo << ", " << hi << ")" << std::endl;
+	std::cout << "Score step:         " << (hi - lo) / (SCORE_CODES - 1) << std::endl;
+	return 0;
+}
+
+int runThreshold(int argc, char** argv) {
+	ScoreMap map;
+	std::vector<float> thresholds;
+	std::string maskFile, refFile;
+
+	if(argc < 2) {
+		printUsage();
+		return 1;
+	}
+
+	for(int k = 1; k < argc; k++) {
+		std::string arg = argv[k];
+		if(arg == "-o" && k + 1 < argc) {
+			maskFile = argv[++k];
+		}
+		else if(arg == "-ref" && k + 1 < argc) {
+			refFile = argv[++k];
+		}
+		else {
+			thresholds.push_back(atof(argv[k]));
+		}
+	}
+	if(thresholds.empty()) {
+		printUsage();
+		return 1;
+	}
+
+	openScoreMap(argv[0], map);
+	int rows = map.header.rows, cols = map.header.cols;
+
+	// Scores outside the map's range were clamped to its ends
+	for(size_t k = 0; k < thresholds.size(); k++) {
+		if(thresholds[k] < map.header.lo || thresholds[k] >= map.header.hi) {
+			std::cout << "Error: Threshold " << thresholds[k] << " is outside the score range ["
+				<< map.header.lo << ", " << map.header.hi << ")" << std::endl;
+			closeScoreMap(map);
+			return 1;
+		}
+	}
+
+	if(!maskFile.empty()) {
+		std::vector<unsigned char> mask((size_t)rows * cols);
+		thresholdScoreMap(map, thresholds[0], mask.data());
+		writeImageBuffer((char*)maskFile.c_str(), mask.data(), rows, cols, 255, false);
+	}
+
+	// One pass over the map answers every threshold
+	if(!refFile.empty()) {
+		ImageType ref;
+		ScoreHistogram hist;
+		getImage((char*)refFile.c_str(), ref);
+		histogramForScoreMap(map, ref, hist);
+
+		std::cout << "t\tFP\tFN" << std::endl;
+		for(size_t k = 0; k < thresholds.size(); k++) {
+			long fp, fn;
+			misclassForHistogram(hist, map.header, thresholds[k], fp, fn);
+			std::cout << thresholds[k] << "\t" << fp << "\t" << fn << std::endl;
+		}
+	}
+
+	closeScoreMap(map);
+	return 0;
+}
+
+int runEvaluate(int argc, char** argv) {
+	std::vector<std::string> modelFiles, images;
+	std::vector<float> thresholds;
+
+	for(int k = 0; k < argc; k++) {
+		std::string arg = argv[k];
+		if(arg == "-m" && k + 1 < argc) {
+			modelFiles.push_back(argv[++k]);
+		}
+		else if(arg == "-t" && k + 1 < argc) {
+			thresholds.push_back(atof(argv[++k]));
+		}
+		else {
+			images.push_back(arg);
+		}
+	}
+	if(modelFiles.empty() || images.empty() || images.size() % 2 != 0) {
+		printUsage();
+		return 1;
+	}
+
+	// Every model is counted at its own threshold and every -t
+	std::vector<ModelEvaluation> evals(modelFiles.size());
+	for(size_t m = 0; m < modelFiles.size(); m++) {
+		SkinModel model;
+		loadSkinModel((char*)modelFiles[m].c_str(), model);
+		std::vector<float> own(thresholds);
+		own.push_back(model.t);
+		prepareModelEvaluation(model, own, evals[m]);
+	}
+
+	for(size_t k = 0; k < images.size(); k += 2) {
+		ImageType image, ref;
+		getImage((char*)images[k].c_str(), image);
+		getImage((char*)images[k + 1].c_str(), ref);
+		evaluateModels(image, &ref, evals);
+	}
+
+	std::cout << "model\tt\tTP\tFP\tTN\tFN" << std::endl;
+	for(size_t m = 0; m < evals.size(); m++) {
+		for(size_t k = 0; k < evals[m].thresholds.size(); k++) {
+			const ConfusionMatrix& counts = evals[m].counts[k];
+			std::cout << modelFiles[m] << "\t" << evals[m].thresholds[k] << "\t"
+				<< counts.tp << "\t" << counts.fp << "\t"
+				<< counts.tn << "\t" << counts.fn << std::endl;
+		}
+	}
+	return 0;
+}
+
+int runCrossValidatePoints(int argc, char** argv) {
+	int folds = 5;
+	unsigned seed = 1;
+
+	if(argc < 1) {
+		printUsage();
+		return 1;
+	}
+	for(int k = 1; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-k") {
+			folds = atoi(argv[k + 1]);
+		}
+		else if(arg == "-seed") {
+			seed = (unsigned)strtoul(argv[k + 1], NULL, 10);
+		}
+	}
+
+	PointColumns points;
+	loadPointColumns(argv[0], points);
+	reportMalformedLines(argv[0], points);
+
+	std::vector<PointFoldResult> results;
+	crossValidatePoints(points, folds, seed, results);
+
+	long tested = 0, misclass = 0;
+	std::cout << "fold\tclass1\terr1\tclass2\terr2\trate" << std::endl;
+	for(size_t f = 0; f < results.size(); f++) {
+		const PointFoldResult& r = results[f];
+		long foldTested = r.tested[0] + r.tested[1];
+		long foldMisclass = r.misclass[0] + r.misclass[1];
+		std::cout << f + 1 << "\t" << r.tested[0] << "\t" << r.misclass[0] << "\t"
+			<< r.tested[1] << "\t" << r.misclass[1] << "\t"
+			<< (float)foldMisclass / foldTested << std::endl;
+		tested += foldTested;
+		misclass += foldMisclass;
+	}
+	std::cout << "total\t" << tested << " points\t" << misclass << " misclassified\t"
+		<< (float)misclass / tested << std::endl;
+	return 0;
+}
+
+int runCrossValidateImages(int argc, char** argv) {
+	std::vector<char*> images;
+	int folds = 5;
+	float t[2];
+	SkinModel model;
+
+	defaultSkinModel(false, model);
+	t[0] = model.t;
+	defaultSkinModel(true, model);
+	t[1] = model.t;
+	for(int k = 0; k < argc; k++) {
+		std::string arg = argv[k];
+		if(arg == "-k" && k + 1 < argc) {
+			folds = atoi(argv[++k]);
+		}
+		else if(arg == "-t-rgb" && k + 1 < argc) {
+			t[1] = atof(argv[++k]);
+		}
+		else if(arg == "-t-ycc" && k + 1 < argc) {
+			t[0] = atof(argv[++k]);
+		}
+		else {
+			images.push_back(argv[k]);
+		}
+	}
+	if(images.empty() || images.size() % 2 != 0) {
+		printUsage();
+		return 1;
+	}
+
+	std::vector<char*> trainFNames, refFNames;
+	for(size_t k = 0; k < images.size(); k += 2) {
+		trainFNames.push_back(images[k]);
+		refFNames.push_back(images[k + 1]);
+	}
+	int count = (int)trainFNames.size();
+	if(folds > count) {
+		folds = count;
+	}
+
+	std::vector<ImageFoldResult> results;
+	crossValidateImages(trainFNames.data(), refFNames.data(), count, folds, t, results);
+
+	ConfusionMatrix total[2] = { { 0, 0, 0, 0 }, { 0, 0, 0, 0 } };
+	std::cout << "fold\timages\tscheme\tTP\tFP\tTN\tFN" << std::endl;
+	for(size_t f = 0; f < results.size(); f++) {
+		for(int c = 1; c >= 0; c--) {
+			const ConfusionMatrix& counts = results[f].counts[c];
+			std::cout << f + 1 << "\t" << results[f].images << "\t" << (c ? "rgb" : "ycc") << "\t"
+				<< counts.tp << "\t" << counts.fp << "\t"
+				<< counts.tn << "\t" << counts.fn << std::endl;
+			total[c].tp += counts.tp;
+			total[c].fp += counts.fp;
+			total[c].tn += counts.tn;
+			total[c].fn += counts.fn;
+		}
+	}
+	for(int c = 1; c >= 0; c--) {
+		std::cout << "total\t" << count << "\t" << (c ? "rgb" : "ycc") << "\t"
+			<< total[c].tp << "\t" << total[c].fp << "\t"
+			<< total[c].tn << "\t" << total[c].fn << std::endl;
+	}
+	return 0;
+}
+
+// Prints the mean, deviation, and 95% band of a value over repetitions
+void printCurveValues(const std::vector<float>& values) {
+	float mean, sd, lo, hi;
+	summarizeCurveValues(values, mean, sd, lo, hi);
+	std::cout << "\t" << mean << "\t" << sd << "\t" << lo << "\t" << hi;
+}
+
+int runLearningCurve(int argc, char** argv) {
+	std::vector<double> fractions;
+	int repetitions = 100;
+	unsigned seed = 1;
+
+	if(argc < 1) {
+		printUsage();
+		return 1;
+	}
+	for(int k = 1; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-f") {
+			fractions.push_back(atof(argv[k + 1]));
+		}
+		else if(arg == "-reps") {
+			repetitions = atoi(argv[k + 1]);
+		}
+		else if(arg == "-seed") {
+			seed = (unsigned)strtoul(argv[k + 1], NULL, 10);
+		}
+	}
+	if(fractions.empty()) {
+		double defaults[] = { 0.0001, 0.001, 0.01, 0.1 };
+		fractions.assign(defaults, defaults + 4);
+	}
+
+	PointColumns points;
+	loadPointColumns(argv[0], points);
+	reportMalformedLines(argv[0], points);
+
+	std::vector<CurvePoint> curve;
+	learningCurve(points, fractions, repetitions, seed, curve);
+
+	// One row per size and value: mean, deviation, then the 95% band
+	std::cout << "portion\tn1\tn2\tvalue\tmean\tsd\tlo\thi" << std::endl;
+	for(size_t s = 0; s < curve.size(); s++) {
+		const CurvePoint& point = curve[s];
+		const char* names[] = { "mu1", "mu2", "cov1", "cov2", "error" };
+		const std::vector<float>* values[] = { &point.meanError[0], &point.meanError[1],
+			&point.covError[0], &point.covError[1], &point.errorRate };
+
+		for(int v = 0; v < 5; v++) {
+			std::cout << point.fraction << "\t" << point.count[0] << "\t" << point.count[1]
+				<< "\t" << names[v];
+			printCurveValues(*values[v]);
+			std::cout << std::endl;
+		}
+	}
+	return 0;
+}
+
+int runClassifyPoints(int argc, char** argv) {
+	int resolution = 0;
+	float priorOne = 0.3;
+	float priorTwo = 0.7;
+	std::vector<int> misclassCounts(2);
+	Eigen::Matrix<float, 2, 1> mu1, mu2;
+	Eigen::Matrix2f covm1, covm2;
+
+	if(argc < 3) {
+		printUsage();
+		return 1;
+	}
+	if(argc > 4 && std::string(argv[3]) == "-grid") {
+		resolution = atoi(argv[4]);
+	}
+
+	// Same estimates and priors as experiment2Test()
+	estimate2DMean(argv[0], mu1, mu2);
+	estimate2DCov(argv[0], mu1, mu2, covm1, covm2);
+
+	auto start = std::chrono::steady_clock::now();
+	bayesCaseThree(mu1, mu2, covm1, covm2, priorOne, priorTwo, argv[1], argv[2], resolution);
+	auto end = std::chrono::steady_clock::now();
+
+	misclassifyCount(argv[1], argv[2], misclassCounts);
+	std::cout << "True 1, Incorrect: " << misclassCounts[0] << std::endl;
+	std::cout << "True 2, Incorrect: " << misclassCounts[1] << std::endl;
+	std::cout << "Classified in "
+		<< std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()
+		<< " ms" << std::endl;
+	return 0;
+}
+
+int runHistogramTrain(int argc, char** argv) {
+	std::vector<char*> images;
+	HistogramModel model;
+	float t = 0;
+	int space;
+
+	if(argc < 5) {
+		printUsage();
+		return 1;
+	}
+	std::string name = argv[1];
+	if(name == "rgb3") {
+		space = HIST_SPACE_RGB;
+	}
+	else if(name == "rg") {
+		space = HIST_SPACE_RG;
+	}
+	else if(name == "cbcr") {
+		space = HIST_SPACE_CBCR;
+	}
+	else {
+		printUsage();
+		return 1;
+	}
+	for(int k = 3; k < argc; k++) {
+		if(std::string(argv[k]) == "-t" && k + 1 < argc) {
+			t = atof(argv[++k]);
+		}
+		else {
+			images.push_back(argv[k]);
+		}
+	}
+	if(images.empty() || images.size() % 2 != 0) {
+		printUsage();
+		return 1;
+	}
+
+	initHistogramModel(space, atoi(argv[2]), model);
+	model.t = t;
+	for(size_t k = 0; k < images.size(); k += 2) {
+		ImageType train, ref;
+		getImage(images[k], train);
+		getImage(images[k + 1], ref);
+		addHistogramImages(train, ref, model);
+	}
+	saveHistogramModel(argv[0], model);
+	clearHistogramModel(model);
+	return 0;
+}
+
+int runHistogramClassify(int argc, char** argv) {
+	HistogramModel model;
+	char* refFName = NULL;
+	bool setThreshold = false;
+	float t = 0;
+
+	if(argc < 3) {
+		printUsage();
+		return 1;
+	}
+	for(int k = 3; k + 1 < argc; k += 2) {
+		std::string arg = argv[k];
+		if(arg == "-t") {
+			t = atof(argv[k + 1]);
+			setThreshold = true;
+		}
+		else if(arg == "-ref") {
+			refFName = argv[k + 1];
+		}
+	}
+
+	loadHistogramModel(argv[0], model);
+	if(setThreshold) {
+		model.t = t;
+	}
+
+	ImageType image;
+	int rows, cols, levels;
+	getImage(argv[1], image);
+	image.getImageInfo(rows, cols, levels);
+	ImageType mask(rows, cols, levels);
+	classifyForImageHistogram(image, mask, model);
+	writeImageParallel(argv[2], mask, true);
+
+	if(refFName != NULL) {
+		ImageType ref;
+		int fp, fn;
+		getImage(refFName, ref);
+		getMisclass(mask, ref, fp, fn);
+		std::cout << "FP: " << fp << " FN: " << fn << std::endl;
+	}
+	clearHistogramModel(model);
+	return 0;
+}
+
+int runClean(int argc, char** argv) {
+	ImageType image;
+	BitMask mask;
+
+	if(argc < 2 || argc % 2 != 0) {
+		printUsage();
+		return 1;
+	}
+	for(int k = 2; k < argc; k += 2) {
+		if(!isCleanStep(argv[k])) {
+			printUsage();
+			return 1;
+		}
+	}
+
+	getImage(argv[0], image);
+	maskFromImage(image, mask);
+	for(int k = 2; k < argc; k += 2) {
+		long removed = applyCleanStep(argv[k], atoi(argv[k + 1]), mask);
+		if(std::string(argv[k]) == "-min") {
+			std::cout << "Removed " << removed << " regions" << std::endl;
+		}
+	}
+	imageFromMask(mask, image);
+	writeImageParallel(argv[1], image, true);
+	return 0;
+}
+
+// Reads reference runs from a run mask file, or from a reference image
+void getReferenceRuns(char* fName, RunMask& ref) {
+	std::string name = fName;
+	if(name.size() > 4 && name.compare(name.size() - 4, 4, ".rle") == 0) {
+		loadRunMask(fName, ref);
+	}
+	else {
+		ImageType image;
+		getImage(fName, image);
+		runMaskForReference(image, ref);
+	}
+}
+
+int runRLEClassify(int argc, char** argv) {
+	SkinModel model;
+	ImageType image;
+	RunMask mask;
+
+	if(argc != 3 && !(argc == 5 && std::string(argv[3]) == "-ref")) {
+		printUsage();
+		return 1;
+	}
+
+	loadSkinModel(argv[0], model);
+	getImage(argv[1], image);
+	runMaskForImage(image, model, mask);
+	saveRunMask(argv[2], mask);
+
+	if(argc == 5) {
+		RunMask ref;
+		int fp, fn;
+		getReferenceRuns(argv[4], ref);
+		getMisclassRuns(mask, ref, fp, fn);
+		std::cout << "FP: " << fp << " FN: " << fn << std::endl;
+	}
+	return 0;
+}
+
+int runRLEPack(int argc, char** argv) {
+	ImageType image;
+	RunMask mask;
+
+	if(argc != 2) {
+		printUsage();
+		return 1;
+	}
+	getImage(argv[0], image);
+	runMaskForReference(image, mask);
+	saveRunMask(argv[1], mask);
+	return 0;
+}
+
+int runRLEExpand(int argc, char** argv) {
+	RunMask mask;
+
+	if(argc != 2) {
+		printUsage();
+		return 1;
+	}
+	loadRunMask(argv[0], mask);
+	ImageType image(mask.rows, mask.cols, 255);
+	imageFromRunMask(mask, image);
+	writeImageParallel(argv[1], image, true);
+	return 0;
+}
+
+int runRLEMisclass(int argc, char** argv) {
+	RunMask mask, ref;
+	int fp, fn;
+
+	if(argc != 2) {
+		printUsage();
+		return 1;
+	}
+	loadRunMask(argv[0], mask);
+	getReferenceRuns(argv[1], ref);
+	getMisclassRuns(mask, ref, fp, fn);
+	std::cout << "FP: " << fp << " FN: " << fn << std::endl;
+	return 0;
+}
+
+int runCommand(int argc, char** argv) {
+	if(argc > 1) {
+		std::string command = argv[1];
+		if(command == "batch") {
+			return runBatch(argc - 2, argv + 2);
+		}
+		else if(command == "export-model") {
+			return runExportModel(argc - 2, argv + 2);
+		}
+		else if(command == "export-header") {
+			return runExportHeader(argc - 2, argv + 2);
+		}
+		else if(command == "serve") {
+			return runServe(argc - 2, argv + 2);
+		}
+		else if(command == "client") {
+			return runClient(argc - 2, argv + 2);
+		}
+		else if(command == "fixed-check") {
+			return runFixedCheck(argc - 2, argv + 2);
+		}
+		else if(command == "stream") {
+			return runStream(argc - 2, argv + 2);
+		}
+		else if(command == "stats-add") {
+			return runStatsAdd(argc - 2, argv + 2);
+		}
+		else if(command == "stats-remove") {
+			return runStatsRemove(argc - 2, argv + 2);
+		}
+		else if(command == "stats-model") {
+			return runStatsModel(argc - 2, argv + 2);
+		}
+		else if(command == "score") {
+			return runScore(argc - 2, argv + 2);
+		}
+		else if(command == "threshold") {
+			return runThreshold(argc - 2, argv + 2);
+		}
+		else if(command == "evaluate") {
+			return runEvaluate(argc - 2, argv + 2);
+		}
+		else if(command == "cv-points") {
+			return runCrossValidatePoints(argc - 2, argv + 2);
+		}
+		else if(command == "cv-images") {
+			return runCrossValidateImages(argc - 2, argv + 2);
+		}
+		else if(command == "curve") {
+			return runLearningCurve(argc - 2, argv + 2);
+		}
+		else if(command == "classify-points") {
+			return runClassifyPoints(argc - 2, argv + 2);
+		}
+		else if(command == "hist-train") {
+			return runHistogramTrain(argc - 2, argv + 2);
+		}
+		else if(command == "hist-classify") {
+			return runHistogramClassify(argc - 2, argv + 2);
+		}
+		else if(command == "clean") {
+			return runClean(argc - 2, argv + 2);
+		}
+		else if(command == "rle-classify") {
+			return runRLEClassify(argc - 2, argv + 2);
+		}
+		else if(command == "rle-pack") {
+			return runRLEPack(argc - 2, argv + 2);
+		}
+		else if(command == "rle-expand") {
+			return runRLEExpand(argc - 2, argv + 2);
+		}
+		else if(command == "rle-misclass") {
+			return runRLEMisclass(argc - 2, argv + 2);
+		}
+		printUsage();
+		return 1;
+	}
+
 	experiment1();
 	experiment2();
 	experiment3();
 	return 0;
 }
+
+int main(int argc, char** argv) {
+	// Count memory only when asked to
+	const char* memory = getenv("SKIN_MEMORY");
+	enableMemoryAccounting(memory != NULL && std::string(memory) != "0");
+
+	int status = runCommand(argc, argv);
+
+	// Report on stderr so piped output stays clean
+	if(memoryAccountingEnabled()) {
+		reportImageCacheStats(std::cerr);
+	}
+	clearImageCache();
+	reportMemoryUsage(std::cerr);
+	return status;
+}